@@ -13,7 +13,7 @@
 /*******************************************************************************
  *                     			  INCLUDES                                     *
  *******************************************************************************/
-#include "ADC.h"
+#include "adc.h"
 
 /*******************************************************************************
  *                          Global Variables                                   *
@@ -30,7 +30,7 @@ volatile uint16 g_adcResult = 0;
 ISR(ADC_vect)
 {
 	/* Read ADC Data after conversion complete */
-	g_adcResult = ADC;
+	g_adcResult = REG_READ16(ADC);
 }
 #endif
 
@@ -56,18 +56,17 @@ void ADC_init(void){
 	 * ADLAR   = 0 right adjusted
 	 * MUX4:0  = 00000 to choose channel 0 as initialization
 	 */
-	ADMUX = 0;
+	REG_WRITE(ADMUX,0);
 
 	/* ************************** ADCSRA Description **************************
 	 * ADEN    = 1 Enable ADC
-	 * ADIE    = 1 Enable ADC Interrupt
 	 * ADPS2:0 = 011 to choose ADC_Clock=F_CPU/8=1Mhz/8=125Khz --> ADC must operate in range 50-200Khz
 	 */
-	ADCSRA = (1<<ADEN) | (1<<ADIE) | (1<<ADPS1) | (1<<ADPS0);
+	REG_WRITE(ADCSRA,(1<<ADEN) | (1<<ADPS1) | (1<<ADPS0));
 
 	/* In case working with Interrupt , ADIE = 1 Enable ADC Interrupt */
 #ifdef ADC_INTERRUPT
-	SET_BIT(UCSRB,ADIE);
+	REG_SET_BIT(ADCSRA,ADIE);
 #endif
 }
 
@@ -85,7 +84,7 @@ void ADC_init(void){
 *
 * [returns]: NONE
 *
-* [Remarks]: In main extern g_adcResult to get ADC converted value
+* [Remarks]: ADC_getResult returns the converted value
 *
 *******************************************************************************/
 
@@ -93,9 +92,30 @@ void ADC_readChannel_INT(uint8 channel_num)
 {
 	/* clear first 5 bits in the ADMUX (channel number MUX4:0 bits) before set the required channel
 	 *  choose the correct channel by setting the channel number in MUX4:0 bits     */
-	ADMUX= (ADMUX & 0xE0) | (channel_num & 0x07);
+	REG_WRITE(ADMUX,(REG_READ(ADMUX) & 0xE0) | (channel_num & 0x07));
 
-	SET_BIT(ADCSRA,ADSC); /* start conversion write '1' to ADSC */
+	REG_SET_BIT(ADCSRA,ADSC); /* start conversion write '1' to ADSC */
+}
+
+/******************************************************************************
+*
+* [Function name]: ADC_getResult
+*
+* [Description]: the function returns the last value converted in interrupt mode
+*
+* [Args]: NONE
+*
+* [returns]: last converted value
+*
+* [Remarks]: g_adcResult is written by the ADC ISR one byte at a time , reading it
+*            with the interrupts enabled may give the low byte of a conversion and
+*            the high byte of the next one , so it is read in an atomic section
+*
+*******************************************************************************/
+
+uint16 ADC_getResult(void)
+{
+	return ATOMIC_READ16(g_adcResult);
 }
 
 #else
@@ -116,15 +136,15 @@ void ADC_readChannel_INT(uint8 channel_num)
 uint16 ADC_readChannel(uint8 channel_num){
 	/* clear first 5 bits in the ADMUX (channel number MUX4:0 bits) before set the required channel
 	 *  choose the correct channel by setting the channel number in MUX4:0 bits     */
-	ADMUX= (ADMUX & 0xE0) | (channel_num & 0x07);
-	SET_BIT(ADCSRA,ADSC);
+	REG_WRITE(ADMUX,(REG_READ(ADMUX) & 0xE0) | (channel_num & 0x07));
+	REG_SET_BIT(ADCSRA,ADSC);
 
-	while (BIT_IS_CLEAR(ADCSRA,ADIF)){
+	while (REG_BIT_IS_CLEAR(ADCSRA,ADIF)){
 
 	}
-	SET_BIT(ADCSRA,ADIF);  /* start conversion write '1' to ADSC */
+	REG_SET_BIT(ADCSRA,ADIF);  /* clear the flag by writing '1' to ADIF */
 
-	return ADC;
+	return REG_READ16(ADC);
 }
 
 #endif
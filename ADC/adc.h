@@ -25,6 +25,7 @@ uint16 ADC_readChannel(uint8 channel_num);
 
 #ifdef  ADC_INTERRUPT
 void ADC_readChannel_INT(uint8 channel_num);
+uint16 ADC_getResult(void);
 #endif
 
 #endif /* ADC_H_ */
@@ -34,4 +34,40 @@
 /* Check if a specific bit is cleared in any register and return true if yes */
 #define BIT_IS_CLEAR(REG,BIT) ( !(REG & (1<<BIT)) )
 
+/* The macros above are read-modify-write sequences (in , or , out) , an interrupt that changes
+ * another bit of the same register or variable in between loses its change , except for the
+ * I/O registers 0x00-0x1F (PORTx , DDRx , ...) with a constant bit where the compiler uses sbi/cbi */
+
+/* Set/clear a bit of an I/O register (address 0x00-0x1F , constant bit) with one sbi/cbi instruction ,
+ * it can't be interrupted so it is safe on registers shared with an ISR , a register or a bit
+ * that doesn't fit the instruction gives a compile error instead of a silent read-modify-write */
+#ifndef HOST_SIMULATION
+#define IO_SET_BIT(REG,BIT) __asm__ __volatile__ ("sbi %0,%1" : : "I" (_SFR_IO_ADDR(REG)) , "I" (BIT))
+#define IO_CLEAR_BIT(REG,BIT) __asm__ __volatile__ ("cbi %0,%1" : : "I" (_SFR_IO_ADDR(REG)) , "I" (BIT))
+#else
+#define IO_SET_BIT(REG,BIT) REG_SET_BIT(REG,BIT)
+#define IO_CLEAR_BIT(REG,BIT) REG_CLEAR_BIT(REG,BIT)
+#endif
+
+/* Atomic section: the interrupts are disabled and SREG (the I bit) is restored at the end , so it
+ * can be used with the interrupts enabled or disabled (in an ISR)
+ *   ATOMIC_BEGIN();
+ *   ...
+ *   ATOMIC_END();
+ * both macros in the same block , the memory barrier keeps the accesses inside the section */
+#define ATOMIC_BEGIN() do{ uint8 atomic_sreg = SREG; cli()
+#define ATOMIC_END() __asm__ __volatile__ ("" : : : "memory"); SREG = atomic_sreg; }while(0)
+
+/* Read/write a 16-bit or 32-bit variable shared with an ISR , the AVR accesses it one byte at a time
+ * so an interrupt in the middle gives a torn value (e.g. g_value = ATOMIC_READ16(g_isrCounter);) ,
+ * as in ATOMIC_END the memory barrier keeps the access before the SREG restore */
+#define ATOMIC_READ16(VAR) ({ uint8 atomic_sreg = SREG; uint16 atomic_value; cli(); \
+		atomic_value = (VAR); __asm__ __volatile__ ("" : : : "memory"); SREG = atomic_sreg; atomic_value; })
+#define ATOMIC_READ32(VAR) ({ uint8 atomic_sreg = SREG; uint32 atomic_value; cli(); \
+		atomic_value = (VAR); __asm__ __volatile__ ("" : : : "memory"); SREG = atomic_sreg; atomic_value; })
+#define ATOMIC_WRITE16(VAR,VALUE) do{ uint16 atomic_value = (VALUE); uint8 atomic_sreg = SREG; cli(); \
+		(VAR) = atomic_value; __asm__ __volatile__ ("" : : : "memory"); SREG = atomic_sreg; }while(0)
+#define ATOMIC_WRITE32(VAR,VALUE) do{ uint32 atomic_value = (VALUE); uint8 atomic_sreg = SREG; cli(); \
+		(VAR) = atomic_value; __asm__ __volatile__ ("" : : : "memory"); SREG = atomic_sreg; }while(0)
+
 #endif /* COMMON_MACROS_H_ */
@@ -0,0 +1,579 @@
+ /******************************************************************************
+ *
+ * Module: HAL - Host
+ *
+ * File Name: hal_host.c
+ *
+ * Description: Register model of the ATmega32 peripherals used when the drivers are
+ *              built on the PC (HOST_SIMULATION) , the simulated time advances one cycle
+ *              for every register access and the peripherals are updated lazily on
+ *              every access , so the busy wait loops of the drivers terminate after the
+ *              same number of cycles as on the target (within the access granularity)
+ *
+ * Author: Ganna Ahmed
+ *
+ *******************************************************************************/
+
+#include "micro_configurations.h"
+
+/*******************************************************************************
+ *                          Preprocessor Macros                                *
+ *******************************************************************************/
+
+#define HAL_UART_FIFO_SIZE 256        /* received bytes waiting to be read (power of 2) */
+#define HAL_UART_LOG_SIZE 1024        /* transmitted bytes kept for the test */
+
+#define HAL_EEPROM_SIZE 2048          /* 24C16 : 8 blocks of 256 bytes */
+#define HAL_EEPROM_ADDRESS 0xA0
+#define HAL_EEPROM_PAGE_SIZE 16
+#define HAL_EEPROM_WRITE_MS 5         /* internal write cycle , the device NACKs its address meanwhile */
+
+#define HAL_BIT(BIT) (1<<(BIT))
+
+/*******************************************************************************
+ *                          Types Declaration                                  *
+ *******************************************************************************/
+
+typedef enum
+{
+	TWI_IDLE,TWI_ADDRESS,TWI_WORD_ADDRESS,TWI_WRITE,TWI_READ,TWI_NOT_ADDRESSED
+}hal_twiState;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static uint8 g_regs[HAL_REGISTERS_NUM];
+static uint64 g_cycles;
+static uint8 g_sreg;                 /* bit 7 : global interrupt enable */
+static uint8 g_inIsr;
+
+/* UART */
+static uint8 g_uartUbrrh;
+static uint8 g_uartTxBufferFull;      /* UDR holds a byte waiting for the shift register */
+static uint8 g_uartTxActive;          /* shift register is sending */
+static uint64 g_uartTxShiftEnd;
+static uint8 g_uartRxFifo[HAL_UART_FIFO_SIZE];
+static uint64 g_uartRxArrival[HAL_UART_FIFO_SIZE];
+static uint16 g_uartRxHead;
+static uint16 g_uartRxTail;
+static uint64 g_uartRxLastArrival;
+static uint8 g_uartTxLog[HAL_UART_LOG_SIZE];
+static uint16 g_uartTxCount;
+
+/* TWI and the EEPROM on the bus */
+static hal_twiState g_twiState;
+static uint8 g_twiStatus;
+static uint64 g_twiDoneAt;
+static uint8 g_twiPending;            /* TWINT is set at g_twiDoneAt */
+static uint8 g_twiBusOwned;
+static uint8 g_twiWritten;            /* data bytes written in this transfer */
+static uint16 g_eepromPointer;
+static uint64 g_eepromBusyUntil;
+static uint8 g_eepromMemory[HAL_EEPROM_SIZE];
+
+/* ADC */
+static uint16 g_adcInput[8];
+static uint8 g_adcConverting;
+static uint8 g_adcFirstDone;
+static uint64 g_adcDoneAt;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Weak default of the ADC interrupt , replaced by the ISR of the ADC driver when it is linked */
+__attribute__((weak)) void ADC_vect(void)
+{
+}
+
+static uint64 HAL_uartFrameCycles(void)
+{
+	uint16 ubrr = ((uint16)(g_uartUbrrh & 0x0F)<<8) | g_regs[HAL_UBRRL];
+	uint8 ucsrc = g_regs[HAL_UCSRC];
+	uint8 bits;
+
+	/* start bit + data bits + parity bit + stop bits */
+	bits = 1 + 5 + ((ucsrc>>UCSZ0) & 0x03) + ((g_regs[HAL_UCSRB] & HAL_BIT(UCSZ2)) ? 4 : 0);
+	bits += (ucsrc & HAL_BIT(UPM1)) ? 1 : 0;
+	bits += (ucsrc & HAL_BIT(USBS)) ? 2 : 1;
+
+	return (uint64)bits * (ubrr + 1) * ((g_regs[HAL_UCSRA] & HAL_BIT(U2X)) ? 8 : 16);
+}
+
+static void HAL_uartUpdate(void)
+{
+	/* UDR moves to the shift register once the previous frame is shifted out */
+	if(g_uartTxBufferFull && (g_cycles >= g_uartTxShiftEnd))
+	{
+		g_uartTxBufferFull = 0;
+		g_uartTxShiftEnd += HAL_uartFrameCycles();
+	}
+	if(g_uartTxActive && !g_uartTxBufferFull && (g_cycles >= g_uartTxShiftEnd))
+	{
+		g_uartTxActive = 0;
+		g_regs[HAL_UCSRA] |= HAL_BIT(TXC);
+	}
+	if(g_uartTxBufferFull)
+	{
+		g_regs[HAL_UCSRA] &= ~HAL_BIT(UDRE);
+	}
+	else
+	{
+		g_regs[HAL_UCSRA] |= HAL_BIT(UDRE);
+	}
+
+	if((g_uartRxHead != g_uartRxTail) && (g_uartRxArrival[g_uartRxTail] <= g_cycles)
+			&& (g_regs[HAL_UCSRB] & HAL_BIT(RXEN)))
+	{
+		g_regs[HAL_UCSRA] |= HAL_BIT(RXC);
+	}
+	else
+	{
+		g_regs[HAL_UCSRA] &= ~HAL_BIT(RXC);
+	}
+}
+
+static void HAL_uartWriteData(uint8 value)
+{
+	if(!(g_regs[HAL_UCSRB] & HAL_BIT(TXEN)) || g_uartTxBufferFull)
+	{
+		return;    /* transmitter disabled or data overwritten while UDRE is cleared */
+	}
+	if(g_uartTxCount < HAL_UART_LOG_SIZE)
+	{
+		g_uartTxLog[g_uartTxCount++] = value;
+	}
+	if(g_uartTxActive)
+	{
+		g_uartTxBufferFull = 1;
+	}
+	else
+	{
+		g_uartTxActive = 1;
+		g_uartTxShiftEnd = g_cycles + HAL_uartFrameCycles();
+	}
+	HAL_uartUpdate();
+}
+
+static uint8 HAL_uartReadData(void)
+{
+	uint8 data = 0;
+
+	if(g_regs[HAL_UCSRA] & HAL_BIT(RXC))
+	{
+		data = g_uartRxFifo[g_uartRxTail];
+		g_uartRxTail = (g_uartRxTail + 1) & (HAL_UART_FIFO_SIZE - 1);
+		HAL_uartUpdate();
+	}
+	return data;
+}
+
+static uint64 HAL_twiBitCycles(void)
+{
+	/* SCL period = 16 + 2 * TWBR * 4^TWPS */
+	return 16 + 2 * (uint64)g_regs[HAL_TWBR] * (1 << (2 * (g_regs[HAL_TWSR] & 0x03)));
+}
+
+static void HAL_twiUpdate(void)
+{
+	if(g_twiPending && (g_cycles >= g_twiDoneAt))
+	{
+		g_twiPending = 0;
+		g_regs[HAL_TWCR] |= HAL_BIT(TWINT);
+	}
+}
+
+static void HAL_twiAddress(uint8 sla)
+{
+	uint8 read = sla & 0x01;
+
+	if(((sla & 0xF0) == HAL_EEPROM_ADDRESS) && (g_cycles >= g_eepromBusyUntil))
+	{
+		g_twiStatus = read ? 0x40 : 0x18;
+		/* 24C16 : the three address bits are the block (the high bits of the word address) */
+		g_eepromPointer = (g_eepromPointer & 0x00FF) | ((uint16)(sla & 0x0E)<<7);
+		g_twiState = read ? TWI_READ : TWI_WORD_ADDRESS;
+	}
+	else
+	{
+		g_twiStatus = read ? 0x48 : 0x20;
+		g_twiState = TWI_NOT_ADDRESSED;
+	}
+}
+
+static void HAL_twiControl(uint8 value)
+{
+	uint8 ack = value & HAL_BIT(TWEA);
+
+	/* TWINT is cleared by writing one to it , the other bits are written */
+	g_regs[HAL_TWCR] = (g_regs[HAL_TWCR] & HAL_BIT(TWINT)) | (value & ~HAL_BIT(TWINT));
+	if(!(value & HAL_BIT(TWINT)) || !(value & HAL_BIT(TWEN)))
+	{
+		return;
+	}
+	g_regs[HAL_TWCR] &= ~HAL_BIT(TWINT);
+
+	if(value & HAL_BIT(TWSTO))
+	{
+		/* the EEPROM starts its write cycle when the stop follows written data */
+		if((g_twiState == TWI_WRITE) && g_twiWritten)
+		{
+			g_eepromBusyUntil = g_cycles + (uint64)HAL_EEPROM_WRITE_MS * (F_CPU / 1000);
+		}
+		g_twiState = TWI_IDLE;
+		g_twiBusOwned = 0;
+		g_twiStatus = 0xF8;
+		g_regs[HAL_TWCR] &= ~HAL_BIT(TWSTO);
+		return;
+	}
+
+	if(value & HAL_BIT(TWSTA))
+	{
+		if((g_twiState == TWI_WRITE) && g_twiWritten)
+		{
+			g_eepromBusyUntil = g_cycles + (uint64)HAL_EEPROM_WRITE_MS * (F_CPU / 1000);
+		}
+		g_twiStatus = g_twiBusOwned ? 0x10 : 0x08;
+		g_twiBusOwned = 1;
+		g_twiWritten = 0;
+		g_twiState = TWI_ADDRESS;
+		g_twiDoneAt = g_cycles + HAL_twiBitCycles();
+		g_twiPending = 1;
+		return;
+	}
+
+	switch(g_twiState)
+	{
+	case TWI_ADDRESS:
+		HAL_twiAddress(g_regs[HAL_TWDR]);
+		break;
+	case TWI_WORD_ADDRESS:
+		g_eepromPointer = (g_eepromPointer & 0x0700) | g_regs[HAL_TWDR];
+		g_twiStatus = 0x28;
+		g_twiState = TWI_WRITE;
+		break;
+	case TWI_WRITE:
+		g_eepromMemory[g_eepromPointer] = g_regs[HAL_TWDR];
+		/* the address counter rolls over inside the page */
+		g_eepromPointer = (g_eepromPointer & ~(HAL_EEPROM_PAGE_SIZE - 1))
+				| ((g_eepromPointer + 1) & (HAL_EEPROM_PAGE_SIZE - 1));
+		g_twiWritten = 1;
+		g_twiStatus = 0x28;
+		break;
+	case TWI_READ:
+		g_regs[HAL_TWDR] = g_eepromMemory[g_eepromPointer];
+		g_eepromPointer = (g_eepromPointer + 1) & (HAL_EEPROM_SIZE - 1);
+		g_twiStatus = ack ? 0x50 : 0x58;
+		break;
+	default:
+		/* nobody answers : data NACK (transmitter) or the bus floats high (receiver) */
+		g_regs[HAL_TWDR] = 0xFF;
+		g_twiStatus = 0x30;
+		break;
+	}
+	/* address or data byte + acknowledge bit */
+	g_twiDoneAt = g_cycles + 9 * HAL_twiBitCycles();
+	g_twiPending = 1;
+}
+
+static void HAL_adcUpdate(void)
+{
+	uint16 result;
+
+	if(!g_adcConverting || (g_cycles < g_adcDoneAt))
+	{
+		return;
+	}
+	g_adcConverting = 0;
+	g_adcFirstDone = 1;
+
+	result = g_adcInput[g_regs[HAL_ADMUX] & 0x07] & 0x03FF;
+	if(g_regs[HAL_ADMUX] & HAL_BIT(ADLAR))
+	{
+		result <<= 6;
+	}
+	g_regs[HAL_ADCL] = (uint8)result;
+	g_regs[HAL_ADCH] = (uint8)(result>>8);
+	g_regs[HAL_ADCSRA] = (g_regs[HAL_ADCSRA] & ~HAL_BIT(ADSC)) | HAL_BIT(ADIF);
+}
+
+static void HAL_adcControl(uint8 value)
+{
+	uint8 old = g_regs[HAL_ADCSRA];
+	uint8 prescaler;
+
+	/* ADIF is cleared by writing one to it */
+	g_regs[HAL_ADCSRA] = (value & ~(HAL_BIT(ADIF) | HAL_BIT(ADSC)))
+			| (old & HAL_BIT(ADSC)) | (old & ~value & HAL_BIT(ADIF));
+
+	if(!(value & HAL_BIT(ADEN)))
+	{
+		g_adcConverting = 0;
+		g_adcFirstDone = 0;
+		g_regs[HAL_ADCSRA] &= ~HAL_BIT(ADSC);
+	}
+	else if((value & HAL_BIT(ADSC)) && !g_adcConverting)
+	{
+		prescaler = 1 << (value & 0x07);
+		if(prescaler == 1)
+		{
+			prescaler = 2;
+		}
+		g_adcConverting = 1;
+		g_adcDoneAt = g_cycles + (uint64)(g_adcFirstDone ? 13 : 25) * prescaler;
+		g_regs[HAL_ADCSRA] |= HAL_BIT(ADSC);
+	}
+}
+
+static void HAL_update(void)
+{
+	HAL_uartUpdate();
+	HAL_twiUpdate();
+	HAL_adcUpdate();
+
+	/* conversion complete interrupt , called with the interrupts disabled as on the target */
+	if((g_sreg & HAL_BIT(7)) && !g_inIsr && (g_regs[HAL_ADCSRA] & HAL_BIT(ADIE))
+			&& (g_regs[HAL_ADCSRA] & HAL_BIT(ADIF)))
+	{
+		g_inIsr = 1;
+		g_sreg &= ~HAL_BIT(7);
+		g_regs[HAL_ADCSRA] &= ~HAL_BIT(ADIF);
+		ADC_vect();
+		g_sreg |= HAL_BIT(7);
+		g_inIsr = 0;
+	}
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+uint8 HAL_read(HAL_RegisterType reg)
+{
+	uint8 value;
+
+	g_cycles++;
+	HAL_update();
+
+	switch(reg)
+	{
+	case HAL_UDR:
+		value = HAL_uartReadData();
+		break;
+	case HAL_UCSRC:
+		value = g_regs[HAL_UCSRC] | HAL_BIT(URSEL);
+		break;
+	case HAL_UBRRH:
+		value = g_uartUbrrh;
+		break;
+	case HAL_TWSR:
+		value = (g_regs[HAL_TWCR] & HAL_BIT(TWINT) ? g_twiStatus : 0xF8) | (g_regs[HAL_TWSR] & 0x03);
+		break;
+	case HAL_ADC:
+		value = g_regs[HAL_ADCL];
+		break;
+	default:
+		value = g_regs[reg];
+		break;
+	}
+	return value;
+}
+
+uint16 HAL_read16(HAL_RegisterType reg)
+{
+	if(reg == HAL_ADC)
+	{
+		g_cycles += 2;
+		HAL_update();
+		return ((uint16)g_regs[HAL_ADCH]<<8) | g_regs[HAL_ADCL];
+	}
+	return HAL_read(reg);
+}
+
+void HAL_write(HAL_RegisterType reg,uint8 value)
+{
+	g_cycles++;
+	HAL_update();
+
+	switch(reg)
+	{
+	case HAL_UDR:
+		HAL_uartWriteData(value);
+		break;
+	case HAL_UCSRA:
+		/* U2X and MPCM are written , TXC is cleared by writing one to it */
+		g_regs[HAL_UCSRA] = (g_regs[HAL_UCSRA] & 0xFC) | (value & 0x03);
+		if(value & HAL_BIT(TXC))
+		{
+			g_regs[HAL_UCSRA] &= ~HAL_BIT(TXC);
+		}
+		break;
+	case HAL_UCSRC:
+	case HAL_UBRRH:
+		/* UCSRC and UBRRH share the same address , URSEL selects the register */
+		if(value & HAL_BIT(URSEL))
+		{
+			g_regs[HAL_UCSRC] = value & ~HAL_BIT(URSEL);
+		}
+		else
+		{
+			g_uartUbrrh = value & 0x0F;
+		}
+		break;
+	case HAL_TWCR:
+		HAL_twiControl(value);
+		break;
+	case HAL_TWSR:
+		g_regs[HAL_TWSR] = value & 0x03;
+		break;
+	case HAL_ADCSRA:
+		HAL_adcControl(value);
+		break;
+	case HAL_ADCL:
+	case HAL_ADCH:
+	case HAL_ADC:
+		break;    /* read only */
+	default:
+		g_regs[reg] = value;
+		break;
+	}
+	HAL_update();
+}
+
+/* SREG of the simulation , an interrupt enabled by writing it is taken at the next register access */
+uint8 * HAL_statusRegister(void)
+{
+	return &g_sreg;
+}
+
+void HAL_setInterrupts(uint8 enable)
+{
+	if(enable)
+	{
+		g_sreg |= HAL_BIT(7);
+	}
+	else
+	{
+		g_sreg &= ~HAL_BIT(7);
+	}
+	HAL_update();
+}
+
+void HAL_delayCycles(uint64 cycles)
+{
+	g_cycles += cycles;
+	HAL_update();
+}
+
+ /******************************************************************************
+ *
+ * [Function name]: HAL_reset
+ *
+ * [Description]: puts every modeled register in its reset value , clears the simulated
+ *                time , the UART buffers and fills the EEPROM with 0xFF (erased)
+ *
+ *******************************************************************************/
+void HAL_reset(void)
+{
+	uint16 i;
+
+	for(i = 0 ; i < HAL_REGISTERS_NUM ; i++)
+	{
+		g_regs[i] = 0;
+	}
+	g_regs[HAL_UCSRA] = HAL_BIT(UDRE);
+	g_regs[HAL_UCSRC] = HAL_BIT(UCSZ1) | HAL_BIT(UCSZ0);
+	g_regs[HAL_TWDR] = 0xFF;
+	g_cycles = 0;
+	g_sreg = 0;
+	g_inIsr = 0;
+
+	g_uartUbrrh = 0;
+	g_uartTxBufferFull = 0;
+	g_uartTxActive = 0;
+	g_uartRxHead = 0;
+	g_uartRxTail = 0;
+	g_uartRxLastArrival = 0;
+	g_uartTxCount = 0;
+
+	g_twiState = TWI_IDLE;
+	g_twiStatus = 0xF8;
+	g_twiPending = 0;
+	g_twiBusOwned = 0;
+	g_twiWritten = 0;
+	g_eepromPointer = 0;
+	g_eepromBusyUntil = 0;
+	for(i = 0 ; i < HAL_EEPROM_SIZE ; i++)
+	{
+		g_eepromMemory[i] = 0xFF;
+	}
+
+	for(i = 0 ; i < 8 ; i++)
+	{
+		g_adcInput[i] = 0;
+	}
+	g_adcConverting = 0;
+	g_adcFirstDone = 0;
+}
+
+uint64 HAL_getCycles(void)
+{
+	return g_cycles;
+}
+
+ /******************************************************************************
+ *
+ * [Function name]: HAL_uartReceive
+ *
+ * [Description]: the other side of the line sends len bytes , they arrive back to back
+ *                one frame time apart (at the baud rate configured by the driver)
+ *
+ *******************************************************************************/
+void HAL_uartReceive(const uint8 * data,uint16 len)
+{
+	uint64 frame = HAL_uartFrameCycles();
+	uint16 i;
+
+	if(g_uartRxLastArrival < g_cycles)
+	{
+		g_uartRxLastArrival = g_cycles;
+	}
+	for(i = 0 ; i < len ; i++)
+	{
+		if(((g_uartRxHead + 1) & (HAL_UART_FIFO_SIZE - 1)) == g_uartRxTail)
+		{
+			break;
+		}
+		g_uartRxLastArrival += frame;
+		g_uartRxFifo[g_uartRxHead] = data[i];
+		g_uartRxArrival[g_uartRxHead] = g_uartRxLastArrival;
+		g_uartRxHead = (g_uartRxHead + 1) & (HAL_UART_FIFO_SIZE - 1);
+	}
+}
+
+/* Copies the bytes written to UDR since the last call , returns their number */
+uint16 HAL_uartGetTransmitted(uint8 * buff,uint16 max)
+{
+	uint16 i;
+	uint16 count = (g_uartTxCount < max) ? g_uartTxCount : max;
+
+	for(i = 0 ; i < count ; i++)
+	{
+		buff[i] = g_uartTxLog[i];
+	}
+	g_uartTxCount = 0;
+	return count;
+}
+
+/* Sets the 10-bit value the ADC converts on a channel */
+void HAL_adcSetInput(uint8 channel,uint16 value)
+{
+	g_adcInput[channel & 0x07] = value;
+}
+
+/* Direct access to the 2048 bytes of the simulated 24C16 */
+uint8 * HAL_eepromMemory(void)
+{
+	return g_eepromMemory;
+}
@@ -0,0 +1,128 @@
+ /******************************************************************************
+ *
+ * Module: HAL - Host
+ *
+ * File Name: hal_host.h
+ *
+ * Description: Host (PC) replacement of the avr headers used when HOST_SIMULATION is defined,
+ *              it gives the ATmega32 bit names , the register identifiers used by the REG_
+ *              macros and the functions the tests use to feed and check the simulated peripherals
+ *              Modeled peripherals : UART , TWI with a 24C16 EEPROM at address 0xA0 and ADC
+ *
+ * Author: Ganna Ahmed
+ *
+ *******************************************************************************/
+
+#ifndef HAL_HOST_H_
+#define HAL_HOST_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                      ATmega32 Bits Definitions                              *
+ *******************************************************************************/
+
+/* UCSRA */
+#define RXC   7
+#define TXC   6
+#define UDRE  5
+#define FE    4
+#define DOR   3
+#define PE    2
+#define U2X   1
+#define MPCM  0
+
+/* UCSRB */
+#define RXCIE 7
+#define TXCIE 6
+#define UDRIE 5
+#define RXEN  4
+#define TXEN  3
+#define UCSZ2 2
+#define RXB8  1
+#define TXB8  0
+
+/* UCSRC */
+#define URSEL 7
+#define UMSEL 6
+#define UPM1  5
+#define UPM0  4
+#define USBS  3
+#define UCSZ1 2
+#define UCSZ0 1
+#define UCPOL 0
+
+/* TWCR */
+#define TWINT 7
+#define TWEA  6
+#define TWSTA 5
+#define TWSTO 4
+#define TWWC  3
+#define TWEN  2
+#define TWIE  0
+
+/* TWSR */
+#define TWPS1 1
+#define TWPS0 0
+
+/* ADMUX */
+#define REFS1 7
+#define REFS0 6
+#define ADLAR 5
+
+/* ADCSRA */
+#define ADEN  7
+#define ADSC  6
+#define ADATE 5
+#define ADIF  4
+#define ADIE  3
+#define ADPS2 2
+#define ADPS1 1
+#define ADPS0 0
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+/* Registers modeled by hal_host.c (REG_READ(UDR) becomes HAL_read(HAL_UDR)) */
+typedef enum
+{
+	HAL_UDR,HAL_UCSRA,HAL_UCSRB,HAL_UCSRC,HAL_UBRRL,HAL_UBRRH,
+	HAL_TWBR,HAL_TWSR,HAL_TWAR,HAL_TWDR,HAL_TWCR,
+	HAL_ADMUX,HAL_ADCSRA,HAL_ADCL,HAL_ADCH,HAL_ADC,
+	HAL_REGISTERS_NUM
+}HAL_RegisterType;
+
+/*******************************************************************************
+ *                      avr-libc Replacements                                  *
+ *******************************************************************************/
+
+#define ISR(vector,...) void vector(void)
+#define SREG (*HAL_statusRegister())    /* only the I bit (7) is modeled */
+#define sei() HAL_setInterrupts(1)
+#define cli() HAL_setInterrupts(0)
+#define _delay_ms(ms) HAL_delayCycles((uint64)((ms)*(F_CPU/1000.0)))
+#define _delay_us(us) HAL_delayCycles((uint64)((us)*(F_CPU/1000000.0)))
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/* Register accesses used by the REG_ macros , every access takes one cycle of simulated time */
+uint8 HAL_read(HAL_RegisterType reg);
+uint16 HAL_read16(HAL_RegisterType reg);
+void HAL_write(HAL_RegisterType reg,uint8 value);
+
+uint8 * HAL_statusRegister(void);
+void HAL_setInterrupts(uint8 enable);
+void HAL_delayCycles(uint64 cycles);
+
+/* Test side functions */
+void HAL_reset(void);
+uint64 HAL_getCycles(void);
+void HAL_uartReceive(const uint8 * data,uint16 len);
+uint16 HAL_uartGetTransmitted(uint8 * buff,uint16 max);
+void HAL_adcSetInput(uint8 channel,uint16 value);
+uint8 * HAL_eepromMemory(void);
+
+#endif /* HAL_HOST_H_ */
@@ -0,0 +1,55 @@
+ /******************************************************************************
+ *
+ * Module: HAL - Registers
+ *
+ * File Name: hal_registers.h
+ *
+ * Description: Register access macros used by the drivers
+ *              On the AVR they are the plain register accesses (same in , out , sbi , cbi
+ *              instructions) , with HOST_SIMULATION defined they call the register model
+ *              of hal_host.c so the drivers run and can be measured on the PC
+ *
+ * Author: Ganna Ahmed
+ *
+ *******************************************************************************/
+
+#ifndef HAL_REGISTERS_H_
+#define HAL_REGISTERS_H_
+
+#ifndef HOST_SIMULATION
+
+/* Read a register */
+#define REG_READ(REG) (REG)
+
+/* Read a 16-bit register (low byte first) */
+#define REG_READ16(REG) (REG)
+
+/* Write a register */
+#define REG_WRITE(REG,VALUE) ((REG)=(VALUE))
+
+/* Set a certain bit in a register */
+#define REG_SET_BIT(REG,BIT) ((REG)|=(1<<(BIT)))
+
+/* Clear a certain bit in a register */
+#define REG_CLEAR_BIT(REG,BIT) ((REG)&=(~(1<<(BIT))))
+
+/* Check if a specific bit is set in a register */
+#define REG_BIT_IS_SET(REG,BIT) ( (REG) & (1<<(BIT)) )
+
+/* Check if a specific bit is cleared in a register */
+#define REG_BIT_IS_CLEAR(REG,BIT) ( !((REG) & (1<<(BIT))) )
+
+#else
+
+/* The register name selects its model (HAL_UDR , HAL_TWCR , ...) */
+#define REG_READ(REG) HAL_read(HAL_##REG)
+#define REG_READ16(REG) HAL_read16(HAL_##REG)
+#define REG_WRITE(REG,VALUE) HAL_write(HAL_##REG,(VALUE))
+#define REG_SET_BIT(REG,BIT) HAL_write(HAL_##REG,HAL_read(HAL_##REG)|(1<<(BIT)))
+#define REG_CLEAR_BIT(REG,BIT) HAL_write(HAL_##REG,HAL_read(HAL_##REG)&(~(1<<(BIT))))
+#define REG_BIT_IS_SET(REG,BIT) ( HAL_read(HAL_##REG) & (1<<(BIT)) )
+#define REG_BIT_IS_CLEAR(REG,BIT) ( !(HAL_read(HAL_##REG) & (1<<(BIT))) )
+
+#endif
+
+#endif /* HAL_REGISTERS_H_ */
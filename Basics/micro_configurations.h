@@ -17,8 +17,24 @@
 #define F_CPU 1000000UL //1MHz Clock frequency
 #endif
 
+#ifndef HOST_SIMULATION
 #include <avr/io.h>
 #include <avr/interrupt.h>
 #include <util/delay.h>
+#else
+/* Build on the PC : the registers of the converted drivers are modeled by hal_host.c */
+#include "hal_host.h"
+#endif
+
+#include "hal_registers.h"
+
+/* External interrupts used by the drivers (0 : INT0 (PD2) , 1 : INT1 (PD3) , 2 : INT2 (PB2)) ,
+ * one interrupt can't be used by two drivers , PB2 is the default LCD E pin */
+#define KEYPAD_WAKE_INT 0    /* keypad wake up (KEYPAD_WAKE in keypad.h) */
+#define SPI_SS_INT 1         /* end of frame of the SPI slave (SPI_SLAVE in spi.h) */
+
+#if (KEYPAD_WAKE_INT == SPI_SS_INT)
+#error "Keypad wake up and SPI slave select use the same external interrupt"
+#endif
 
 #endif /* MICRO_CONFIG_H_ */
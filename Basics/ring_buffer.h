@@ -0,0 +1,166 @@
+ /******************************************************************************
+ *
+ * Module: Ring Buffer
+ *
+ * File Name: ring_buffer.h
+ *
+ * Description: Single producer single consumer ring buffer used to pass data between
+ *              an ISR and the main code without disabling the interrupts
+ *              RING_BUFFER_DEFINE(NAME,TYPE,SIZE) generates the type NAME_RingType and
+ *              its functions for one element type and capacity , e.g.
+ *
+ *              RING_BUFFER_DEFINE(uartRx,uint8,64)
+ *              static uartRx_RingType g_rxRing;
+ *              ISR : uartRx_push(&g_rxRing,&data);
+ *              main: while(uartRx_pop(&g_rxRing,&data)) { ... }
+ *
+ *              The head is written by the producer only and the tail by the consumer only ,
+ *              both are one byte (read and written by one instruction) so each side sees
+ *              either the old or the new value of the other one , never a torn value
+ *
+ * Author: Ganna Ahmed
+ *
+ *******************************************************************************/
+
+#ifndef RING_BUFFER_H_
+#define RING_BUFFER_H_
+
+#include "std_types.h"
+
+#ifndef ERROR
+#define ERROR 0
+#endif
+#ifndef SUCCESS
+#define SUCCESS 1
+#endif
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Compiler barrier : the element is stored (or read) before the index that publishes it */
+#define RING_BARRIER() __asm__ __volatile__ ("" : : : "memory")
+
+/* SIZE is a power of 2 up to 128 : the free running 8-bit indices wrap by masking and
+ * head - tail is the number of elements even when the indices overflow */
+#define RING_BUFFER_DEFINE(NAME,TYPE,SIZE) \
+\
+typedef char NAME##_sizeCheck[(((SIZE) & ((SIZE) - 1)) == 0 && (SIZE) <= 128) ? 1 : -1]; \
+\
+typedef struct \
+{ \
+	volatile uint8 s_head;          /* written by the producer */ \
+	volatile uint8 s_tail;          /* written by the consumer */ \
+	volatile uint8 s_highWatermark; /* maximum number of elements since the last reset */ \
+	TYPE s_data[SIZE]; \
+}NAME##_RingType; \
+\
+/* Empties the ring (no producer or consumer may use it meanwhile) */ \
+static inline void NAME##_init(NAME##_RingType * ring_Ptr) \
+{ \
+	ring_Ptr->s_head = 0; \
+	ring_Ptr->s_tail = 0; \
+	ring_Ptr->s_highWatermark = 0; \
+} \
+\
+/* Number of elements waiting for the consumer */ \
+static inline uint8 NAME##_count(const NAME##_RingType * ring_Ptr) \
+{ \
+	return (uint8)(ring_Ptr->s_head - ring_Ptr->s_tail); \
+} \
+\
+/* Number of free elements */ \
+static inline uint8 NAME##_free(const NAME##_RingType * ring_Ptr) \
+{ \
+	return (SIZE) - NAME##_count(ring_Ptr); \
+} \
+\
+/* Producer : gives a contiguous span of free elements at the head , *len_Ptr is its length \
+ * (0 when the ring is full) , the span ends at the end of the array in case it wraps */ \
+static inline TYPE * NAME##_reserve(NAME##_RingType * ring_Ptr,uint8 * len_Ptr) \
+{ \
+	uint8 index = ring_Ptr->s_head & ((SIZE) - 1); \
+	uint8 space = NAME##_free(ring_Ptr); \
+	if(space > (SIZE) - index) \
+	{ \
+		space = (SIZE) - index; \
+	} \
+	*len_Ptr = space; \
+	return &ring_Ptr->s_data[index]; \
+} \
+\
+/* Producer : publishes the first count elements of the reserved span */ \
+static inline void NAME##_commit(NAME##_RingType * ring_Ptr,uint8 count) \
+{ \
+	uint8 head = ring_Ptr->s_head + count; \
+	RING_BARRIER(); \
+	ring_Ptr->s_head = head; \
+	count = (uint8)(head - ring_Ptr->s_tail); \
+	if(count > ring_Ptr->s_highWatermark) \
+	{ \
+		ring_Ptr->s_highWatermark = count; \
+	} \
+} \
+\
+/* Consumer : gives a contiguous span of the waiting elements at the tail , *len_Ptr is its \
+ * length (0 when the ring is empty) , the span ends at the end of the array in case it wraps */ \
+static inline TYPE * NAME##_peek(NAME##_RingType * ring_Ptr,uint8 * len_Ptr) \
+{ \
+	uint8 index = ring_Ptr->s_tail & ((SIZE) - 1); \
+	uint8 count = NAME##_count(ring_Ptr); \
+	if(count > (SIZE) - index) \
+	{ \
+		count = (SIZE) - index; \
+	} \
+	*len_Ptr = count; \
+	RING_BARRIER(); \
+	return &ring_Ptr->s_data[index]; \
+} \
+\
+/* Consumer : frees the first count elements of the peeked span */ \
+static inline void NAME##_release(NAME##_RingType * ring_Ptr,uint8 count) \
+{ \
+	RING_BARRIER(); \
+	ring_Ptr->s_tail += count; \
+} \
+\
+/* Producer : copies one element , returns ERROR when the ring is full \
+ * (TYPE const so a pointer TYPE gives a pointer to a constant pointer) */ \
+static inline uint8 NAME##_push(NAME##_RingType * ring_Ptr,TYPE const * item_Ptr) \
+{ \
+	uint8 head = ring_Ptr->s_head; \
+	if((uint8)(head - ring_Ptr->s_tail) == (SIZE)) \
+	{ \
+		return ERROR; \
+	} \
+	ring_Ptr->s_data[head & ((SIZE) - 1)] = *item_Ptr; \
+	NAME##_commit(ring_Ptr,1); \
+	return SUCCESS; \
+} \
+\
+/* Consumer : takes the oldest element , returns ERROR when the ring is empty */ \
+static inline uint8 NAME##_pop(NAME##_RingType * ring_Ptr,TYPE * item_Ptr) \
+{ \
+	uint8 tail = ring_Ptr->s_tail; \
+	if(tail == ring_Ptr->s_head) \
+	{ \
+		return ERROR; \
+	} \
+	RING_BARRIER(); \
+	*item_Ptr = ring_Ptr->s_data[tail & ((SIZE) - 1)]; \
+	NAME##_release(ring_Ptr,1); \
+	return SUCCESS; \
+} \
+\
+/* Maximum number of elements waiting at the same time (to size the ring) */ \
+static inline uint8 NAME##_highWatermark(const NAME##_RingType * ring_Ptr) \
+{ \
+	return ring_Ptr->s_highWatermark; \
+} \
+\
+static inline void NAME##_resetHighWatermark(NAME##_RingType * ring_Ptr) \
+{ \
+	ring_Ptr->s_highWatermark = 0; \
+}
+
+#endif /* RING_BUFFER_H_ */
@@ -28,6 +28,19 @@ typedef unsigned char bool;
 
 #define NULL_PTR    ((void*)0)
 
+#ifdef HOST_SIMULATION
+/* PC build : long is 64-bit on most hosts , the fixed width types keep the AVR sizes */
+#include <stdint.h>
+
+typedef uint8_t uint8;
+typedef int8_t sint8;
+typedef uint16_t uint16;
+typedef int16_t sint16;
+typedef uint32_t uint32;
+typedef int32_t sint32;
+typedef uint64_t uint64;
+typedef int64_t sint64;
+#else
 typedef unsigned char uint8;                            /*           0:255              */
 typedef signed char sint8;                             /*           -128:+127          */
 typedef unsigned short uint16;                         /*           0:65535            */
@@ -36,6 +49,7 @@ typedef unsigned long uint32;                        /*          0:4294967295
 typedef signed long sint32;                         /*   -2147483648:+2147483647      */
 typedef unsigned long long uint64;                 /*       0:18446744073709551615   */
 typedef signed long long sint64;
+#endif
 typedef float float32;
 typedef double double64;
 
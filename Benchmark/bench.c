@@ -0,0 +1,34 @@
+ /******************************************************************************
+ *
+ * Module: Benchmark
+ *
+ * File Name: bench.c
+ *
+ * Description: Common code of the benchmark firmwares
+ *
+ * Author: Ganna Ahmed
+ *
+ *******************************************************************************/
+
+#include "bench.h"
+#include "micro_configurations.h"
+#include <avr/sleep.h>
+
+ /******************************************************************************
+ *
+ * [Function name]: BENCH_exit
+ *
+ * [Description]: writes BENCH_DONE to the marker register and sleeps with the interrupts
+ *                disabled , simavr stops the simulation as the MCU can never wake up
+ *
+ *******************************************************************************/
+void BENCH_exit(void)
+{
+	BENCH_MARKER = BENCH_DONE;
+	cli();
+	sleep_enable();
+	for(;;)
+	{
+		sleep_cpu();
+	}
+}
@@ -0,0 +1,67 @@
+ /******************************************************************************
+ *
+ * Module: Benchmark
+ *
+ * File Name: bench.h
+ *
+ * Description: Definitions shared by the benchmark firmwares (built for the ATmega32)
+ *              and the simavr runner (built for the PC)
+ *              A firmware marks the beginning and the end of a measured operation by
+ *              writing the benchmark id to the marker register , the runner catches the
+ *              write and takes the cycle counter of the simulator , so the measurement
+ *              costs one out instruction and needs no timer
+ *
+ * Author: Ganna Ahmed
+ *
+ *******************************************************************************/
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Marker register : OCDR (shared with OSCCAL) , the on chip debug register , data space address */
+#define BENCH_MARKER_ADDRESS 0x51
+
+/* Marker values : id (begin) , id | BENCH_END_FLAG (end) , id | BENCH_FAIL_FLAG (wrong result) */
+#define BENCH_END_FLAG  0x40
+#define BENCH_FAIL_FLAG 0x80
+#define BENCH_DONE      0x3F    /* firmware finished , written by BENCH_exit */
+
+/* Benchmark ids */
+#define BENCH_UART_SEND_STRING   0
+#define BENCH_ADC_READ_CHANNEL   1
+#define BENCH_EEPROM_READ_BYTE   2
+#define BENCH_LCD_DISPLAY_STRING 3
+#define BENCH_NUM                4
+
+/* Operations of every measurement */
+#define BENCH_UART_BYTES         64     /* bytes sent by UART_sendString (including the '#' terminal) */
+#define BENCH_UART_BAUD_RATE     9600
+#define BENCH_ADC_CONVERSIONS    100
+#define BENCH_ADC_CHANNEL        0
+#define BENCH_ADC_INPUT_MV       2500   /* input voltage given by the runner , AREF = 5000mV */
+#define BENCH_EEPROM_READS       32
+#define BENCH_EEPROM_TWBR        2      /* SCL = F_CPU / (16 + 2 * TWBR) */
+#define BENCH_LCD_CHARS          16
+
+#ifdef __AVR__
+#define BENCH_MARKER (*(volatile uint8 *)BENCH_MARKER_ADDRESS)
+
+#define BENCH_BEGIN(id) (BENCH_MARKER = (id))
+#define BENCH_END(id)   (BENCH_MARKER = (id) | BENCH_END_FLAG)
+#define BENCH_FAIL(id)  (BENCH_MARKER = (id) | BENCH_FAIL_FLAG)
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/* Function tells the runner the firmware finished and stops the simulation (sleep with the interrupts disabled) */
+void BENCH_exit(void);
+#endif
+
+#endif /* BENCH_H_ */
@@ -0,0 +1,47 @@
+ /******************************************************************************
+ *
+ * Module: Benchmark
+ *
+ * File Name: bench_adc.c
+ *
+ * Description: ADC benchmark firmware : BENCH_ADC_CONVERSIONS polled conversions of
+ *              ADC_readChannel (conversions/s) , the runner gives BENCH_ADC_INPUT_MV
+ *              to the channel and every result is checked
+ *
+ * Author: Ganna Ahmed
+ *
+ *******************************************************************************/
+
+#include "bench.h"
+#include "adc.h"
+
+/* Expected result : input * 1024 / AREF with one LSB of tolerance */
+#define BENCH_ADC_EXPECTED ((uint16)(((uint32)BENCH_ADC_INPUT_MV * 1024) / 5000))
+
+int main(void)
+{
+	uint16 result;
+	uint8 fail = FALSE;
+	uint8 i;
+
+	ADC_init();
+	ADC_readChannel(BENCH_ADC_CHANNEL);    /* the first conversion takes 25 ADC clocks instead of 13 */
+
+	BENCH_BEGIN(BENCH_ADC_READ_CHANNEL);
+	for(i = 0 ; i < BENCH_ADC_CONVERSIONS ; i++)
+	{
+		result = ADC_readChannel(BENCH_ADC_CHANNEL);
+		if((result + 1 < BENCH_ADC_EXPECTED) || (result > BENCH_ADC_EXPECTED + 1))
+		{
+			fail = TRUE;
+		}
+	}
+	BENCH_END(BENCH_ADC_READ_CHANNEL);
+
+	if(fail)
+	{
+		BENCH_FAIL(BENCH_ADC_READ_CHANNEL);
+	}
+	BENCH_exit();
+	return 0;
+}
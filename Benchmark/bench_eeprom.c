@@ -0,0 +1,63 @@
+ /******************************************************************************
+ *
+ * Module: Benchmark
+ *
+ * File Name: bench_eeprom.c
+ *
+ * Description: External EEPROM benchmark firmware : the bytes are written first then
+ *              BENCH_EEPROM_READS random reads of EEPROM_readByte are measured (us per read)
+ *              against the 24C16 emulated by the runner at address 0xA0
+ *
+ * Author: Ganna Ahmed
+ *
+ *******************************************************************************/
+
+#include "bench.h"
+#include "i2c.h"
+#include "externalEEPROM.h"
+
+/* Addresses spread over the 8 blocks of the 24C16 */
+#define BENCH_EEPROM_ADDRESS(i) ((uint16)(i) * 61)
+#define BENCH_EEPROM_DATA(i) ((uint8)(0x5A ^ ((i) * 7)))
+
+int main(void)
+{
+	TWI_ConfigType config = {BENCH_EEPROM_TWBR,0x01};
+	uint8 data[BENCH_EEPROM_READS];
+	uint8 fail = FALSE;
+	uint8 i;
+
+	EEPROM_init(&config);
+	for(i = 0 ; i < BENCH_EEPROM_READS ; i++)
+	{
+		if(EEPROM_writeByte(BENCH_EEPROM_ADDRESS(i),BENCH_EEPROM_DATA(i)) == ERROR)
+		{
+			fail = TRUE;
+		}
+		_delay_ms(10);    /* write cycle of the EEPROM */
+	}
+
+	BENCH_BEGIN(BENCH_EEPROM_READ_BYTE);
+	for(i = 0 ; i < BENCH_EEPROM_READS ; i++)
+	{
+		if(EEPROM_readByte(BENCH_EEPROM_ADDRESS(i),&data[i]) == ERROR)
+		{
+			fail = TRUE;
+		}
+	}
+	BENCH_END(BENCH_EEPROM_READ_BYTE);
+
+	for(i = 0 ; i < BENCH_EEPROM_READS ; i++)
+	{
+		if(data[i] != BENCH_EEPROM_DATA(i))
+		{
+			fail = TRUE;
+		}
+	}
+	if(fail)
+	{
+		BENCH_FAIL(BENCH_EEPROM_READ_BYTE);
+	}
+	BENCH_exit();
+	return 0;
+}
@@ -0,0 +1,36 @@
+ /******************************************************************************
+ *
+ * Module: Benchmark
+ *
+ * File Name: bench_lcd.c
+ *
+ * Description: LCD benchmark firmware : time of LCD_displayString for one row
+ *              (characters/s) with the configuration of lcd.h
+ *
+ * Author: Ganna Ahmed
+ *
+ *******************************************************************************/
+
+#include "bench.h"
+#include "lcd.h"
+
+int main(void)
+{
+	char str[BENCH_LCD_CHARS + 1];
+	uint8 i;
+
+	for(i = 0 ; i < BENCH_LCD_CHARS ; i++)
+	{
+		str[i] = 'a' + i;
+	}
+	str[BENCH_LCD_CHARS] = '\0';
+
+	LCD_init();
+
+	BENCH_BEGIN(BENCH_LCD_DISPLAY_STRING);
+	LCD_displayString(str);
+	BENCH_END(BENCH_LCD_DISPLAY_STRING);
+
+	BENCH_exit();
+	return 0;
+}
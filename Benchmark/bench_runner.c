@@ -0,0 +1,386 @@
+ /******************************************************************************
+ *
+ * Module: Benchmark
+ *
+ * File Name: bench_runner.c
+ *
+ * Description: simavr runner of the benchmark firmwares (built for the PC , links libsimavr)
+ *              Every firmware runs on a simulated ATmega32 with the parts it needs
+ *              (24C16 EEPROM on the TWI bus , ADC input , UART line) , the runner takes
+ *              the cycle counter on every marker write and prints the results as JSON:
+ *
+ *              bench_runner [-f F_CPU] [-b baseline.json] [-t tolerance%] firmware.elf ...
+ *
+ *              With a baseline (a previous output) it exits with 1 when the cycles per
+ *              operation of a benchmark grew more than the tolerance (release gate) , the
+ *              baseline can't be read or misses a benchmark , or a benchmark of the baseline
+ *              was not measured
+ *              It also exits with 1 when a firmware doesn't finish , runs no benchmark or
+ *              begins a benchmark without ending it
+ *
+ * Author: Ganna Ahmed
+ *
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim_avr.h"
+#include "sim_elf.h"
+#include "sim_io.h"
+#include "avr_adc.h"
+#include "avr_twi.h"
+#include "avr_uart.h"
+
+#include "bench.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+#define BENCH_MAX_CYCLES 200000000ULL    /* a firmware that runs longer is stuck */
+#define BENCH_AREF_MV 5000
+
+#define EEPROM_ADDRESS 0xA0
+#define EEPROM_SIZE 2048
+#define EEPROM_PAGE_SIZE 16
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef enum
+{
+	BENCH_RATE,BENCH_TIME    /* operations per second or micro seconds per operation */
+}bench_unitKind;
+
+typedef struct
+{
+	const char * s_name;
+	uint32 s_operations;
+	const char * s_unit;
+	bench_unitKind s_kind;
+}bench_InfoType;
+
+typedef struct
+{
+	uint64 s_begin;
+	uint64 s_cycles;
+	uint8 s_started;
+	uint8 s_measured;
+	uint8 s_failed;
+}bench_ResultType;
+
+typedef struct
+{
+	uint8 s_memory[EEPROM_SIZE];
+	uint16 s_pointer;
+	uint8 s_selected;       /* address byte of the current transfer , 0 when not addressed */
+	uint8 s_index;          /* bytes written since the start (the first one is the word address) */
+	avr_irq_t * s_twiInput;
+}eeprom_Type;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static const bench_InfoType g_benchInfo[BENCH_NUM] =
+{
+	{"uart_send_string",BENCH_UART_BYTES,"bytes/s",BENCH_RATE},
+	{"adc_read_channel",BENCH_ADC_CONVERSIONS,"conversions/s",BENCH_RATE},
+	{"eeprom_read_byte",BENCH_EEPROM_READS,"us/read",BENCH_TIME},
+	{"lcd_display_string",BENCH_LCD_CHARS,"characters/s",BENCH_RATE},
+};
+
+static bench_ResultType g_results[BENCH_NUM];
+static uint8 g_done;
+static uint8 g_started;     /* benchmarks begun by the running firmware */
+static eeprom_Type g_eeprom;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Marker register write : begin , end or failure of a benchmark */
+static void bench_marker(struct avr_t * avr,avr_io_addr_t addr,uint8_t value,void * param)
+{
+	uint8 id = value & ~(BENCH_END_FLAG | BENCH_FAIL_FLAG);
+
+	if(value == BENCH_DONE)
+	{
+		g_done = TRUE;
+		return;
+	}
+	if(id >= BENCH_NUM)
+	{
+		return;
+	}
+	if(value & BENCH_FAIL_FLAG)
+	{
+		g_results[id].s_failed = TRUE;
+	}
+	else if(value & BENCH_END_FLAG)
+	{
+		g_results[id].s_cycles = avr->cycle - g_results[id].s_begin;
+		g_results[id].s_measured = TRUE;
+	}
+	else
+	{
+		g_results[id].s_begin = avr->cycle;
+		g_results[id].s_started = TRUE;
+		g_started++;
+	}
+}
+
+/* 24C16 on the TWI bus : the three low bits of the address select the 256 bytes block */
+static void bench_eepromTwi(struct avr_irq_t * irq,uint32_t value,void * param)
+{
+	eeprom_Type * eeprom = (eeprom_Type *)param;
+	avr_twi_msg_irq_t msg;
+
+	msg.u.v = value;
+
+	if(msg.u.twi.msg & TWI_COND_STOP)
+	{
+		eeprom->s_selected = 0;
+	}
+	if(msg.u.twi.msg & TWI_COND_START)
+	{
+		eeprom->s_selected = 0;
+		eeprom->s_index = 0;
+		if((msg.u.twi.addr & 0xF0) == EEPROM_ADDRESS)
+		{
+			eeprom->s_selected = msg.u.twi.addr;
+			eeprom->s_pointer = (eeprom->s_pointer & 0x00FF) | ((uint16)(msg.u.twi.addr & 0x0E)<<7);
+			avr_raise_irq(eeprom->s_twiInput,avr_twi_irq_msg(TWI_COND_ACK,eeprom->s_selected,1));
+		}
+	}
+	if(!eeprom->s_selected)
+	{
+		return;
+	}
+	if(msg.u.twi.msg & TWI_COND_WRITE)
+	{
+		avr_raise_irq(eeprom->s_twiInput,avr_twi_irq_msg(TWI_COND_ACK,eeprom->s_selected,1));
+		if(eeprom->s_index == 0)
+		{
+			eeprom->s_pointer = (eeprom->s_pointer & 0x0700) | msg.u.twi.data;
+		}
+		else
+		{
+			eeprom->s_memory[eeprom->s_pointer] = msg.u.twi.data;
+			/* the address counter rolls over inside the page */
+			eeprom->s_pointer = (eeprom->s_pointer & ~(EEPROM_PAGE_SIZE - 1))
+					| ((eeprom->s_pointer + 1) & (EEPROM_PAGE_SIZE - 1));
+		}
+		eeprom->s_index++;
+	}
+	if(msg.u.twi.msg & TWI_COND_READ)
+	{
+		avr_raise_irq(eeprom->s_twiInput,
+				avr_twi_irq_msg(TWI_COND_READ,eeprom->s_selected,eeprom->s_memory[eeprom->s_pointer]));
+		eeprom->s_pointer = (eeprom->s_pointer + 1) & (EEPROM_SIZE - 1);
+	}
+}
+
+static void bench_connectParts(avr_t * avr)
+{
+	uint32_t flags = 0;
+
+	/* UART : the line is only timed , nothing is printed */
+	avr_ioctl(avr,AVR_IOCTL_UART_GET_FLAGS('0'),&flags);
+	flags &= ~AVR_UART_FLAG_STDIO;
+	avr_ioctl(avr,AVR_IOCTL_UART_SET_FLAGS('0'),&flags);
+
+	/* ADC input */
+	avr->aref = BENCH_AREF_MV;
+	avr->avcc = BENCH_AREF_MV;
+	avr_raise_irq(avr_io_getirq(avr,AVR_IOCTL_ADC_GETIRQ,ADC_IRQ_ADC0 + BENCH_ADC_CHANNEL),BENCH_ADC_INPUT_MV);
+
+	/* erased 24C16 */
+	memset(g_eeprom.s_memory,0xFF,sizeof(g_eeprom.s_memory));
+	g_eeprom.s_pointer = 0;
+	g_eeprom.s_selected = 0;
+	g_eeprom.s_index = 0;
+	g_eeprom.s_twiInput = avr_io_getirq(avr,AVR_IOCTL_TWI_GETIRQ(0),TWI_IRQ_INPUT);
+	avr_irq_register_notify(avr_io_getirq(avr,AVR_IOCTL_TWI_GETIRQ(0),TWI_IRQ_OUTPUT),bench_eepromTwi,&g_eeprom);
+
+	avr_register_io_write(avr,BENCH_MARKER_ADDRESS,bench_marker,NULL);
+}
+
+/* Runs one firmware until BENCH_exit , returns 0 in case it crashed , never finished or ran no benchmark */
+static int bench_run(const char * file,uint32 frequency)
+{
+	elf_firmware_t firmware;
+	avr_t * avr;
+	int state = cpu_Running;
+
+	memset(&firmware,0,sizeof(firmware));
+	if(elf_read_firmware(file,&firmware) != 0)
+	{
+		fprintf(stderr,"bench_runner: can't read %s\n",file);
+		return 0;
+	}
+	avr = avr_make_mcu_by_name("atmega32");
+	if(avr == NULL)
+	{
+		fprintf(stderr,"bench_runner: simavr has no atmega32 core\n");
+		return 0;
+	}
+	avr_init(avr);
+	avr_load_firmware(avr,&firmware);
+	avr->frequency = frequency;
+	avr->log = LOG_ERROR;
+	bench_connectParts(avr);
+
+	g_done = FALSE;
+	g_started = 0;
+	while(!g_done && (state != cpu_Done) && (state != cpu_Crashed) && (avr->cycle < BENCH_MAX_CYCLES))
+	{
+		state = avr_run(avr);
+	}
+	avr_terminate(avr);
+
+	if(!g_done)
+	{
+		fprintf(stderr,"bench_runner: %s did not finish\n",file);
+		return 0;
+	}
+	if(g_started == 0)
+	{
+		fprintf(stderr,"bench_runner: %s ran no benchmark\n",file);
+		return 0;
+	}
+	return 1;
+}
+
+/* Reads the cycles per operation of a benchmark from a previous output (one benchmark per line) ,
+ * returns 0 in case the benchmark is not in the baseline */
+static int bench_baseline(FILE * f,const char * name,double * cycles_Ptr)
+{
+	char line[512];
+	char key[80];
+	char * field;
+	int found = 0;
+
+	rewind(f);
+	snprintf(key,sizeof(key),"\"name\": \"%s\"",name);
+	while(!found && (fgets(line,sizeof(line),f) != NULL))
+	{
+		field = strstr(line,"\"cycles_per_op\": ");
+		if((strstr(line,key) != NULL) && (field != NULL))
+		{
+			found = (sscanf(field + strlen("\"cycles_per_op\": "),"%lf",cycles_Ptr) == 1);
+		}
+	}
+	return found;
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+int main(int argc,char * argv[])
+{
+	uint32 frequency = 1000000;
+	const char * baseline = NULL;
+	FILE * baselineFile = NULL;
+	int inBaseline;
+	double tolerance = 2.0;
+	int status = 0;
+	int first = TRUE;
+	double perOp;
+	double value;
+	double base;
+	int i;
+
+	for(i = 1 ; i < argc ; i++)
+	{
+		if((strcmp(argv[i],"-f") == 0) && (i + 1 < argc))
+		{
+			frequency = strtoul(argv[++i],NULL,10);
+		}
+		else if((strcmp(argv[i],"-b") == 0) && (i + 1 < argc))
+		{
+			baseline = argv[++i];
+		}
+		else if((strcmp(argv[i],"-t") == 0) && (i + 1 < argc))
+		{
+			tolerance = strtod(argv[++i],NULL);
+		}
+		else if(!bench_run(argv[i],frequency))
+		{
+			status = 1;
+		}
+	}
+
+	if(baseline != NULL)
+	{
+		baselineFile = fopen(baseline,"r");
+		if(baselineFile == NULL)
+		{
+			fprintf(stderr,"bench_runner: can't read the baseline %s\n",baseline);
+			status = 1;
+		}
+	}
+
+	printf("{\n  \"mcu\": \"atmega32\",\n  \"f_cpu\": %lu,\n  \"benchmarks\": [\n",(unsigned long)frequency);
+	for(i = 0 ; i < BENCH_NUM ; i++)
+	{
+		inBaseline = (baselineFile != NULL) && bench_baseline(baselineFile,g_benchInfo[i].s_name,&base);
+		if(!g_results[i].s_measured)
+		{
+			if(g_results[i].s_started)
+			{
+				fprintf(stderr,"bench_runner: %s began but never ended\n",g_benchInfo[i].s_name);
+				status = 1;
+			}
+			else if(inBaseline)
+			{
+				fprintf(stderr,"bench_runner: %s of the baseline was not measured\n",g_benchInfo[i].s_name);
+				status = 1;
+			}
+			continue;
+		}
+		perOp = (double)g_results[i].s_cycles / g_benchInfo[i].s_operations;
+		if(g_benchInfo[i].s_kind == BENCH_RATE)
+		{
+			value = (double)frequency / perOp;
+		}
+		else
+		{
+			value = perOp * 1000000.0 / frequency;
+		}
+		printf("%s    {\"name\": \"%s\", \"operations\": %lu, \"cycles\": %llu, \"cycles_per_op\": %.2f, "
+				"\"value\": %.2f, \"unit\": \"%s\", \"valid\": %s}",
+				first ? "" : ",\n",g_benchInfo[i].s_name,(unsigned long)g_benchInfo[i].s_operations,
+				(unsigned long long)g_results[i].s_cycles,perOp,value,g_benchInfo[i].s_unit,
+				g_results[i].s_failed ? "false" : "true");
+		first = FALSE;
+
+		if(g_results[i].s_failed)
+		{
+			fprintf(stderr,"bench_runner: %s gave wrong results\n",g_benchInfo[i].s_name);
+			status = 1;
+		}
+		if((baselineFile != NULL) && !inBaseline)
+		{
+			fprintf(stderr,"bench_runner: %s is not in the baseline\n",g_benchInfo[i].s_name);
+			status = 1;
+		}
+		else if(inBaseline && (perOp > base * (1.0 + tolerance / 100.0)))
+		{
+			fprintf(stderr,"bench_runner: %s regressed %.2f -> %.2f cycles per operation\n",
+					g_benchInfo[i].s_name,base,perOp);
+			status = 1;
+		}
+	}
+	printf("\n  ]\n}\n");
+
+	if(baselineFile != NULL)
+	{
+		fclose(baselineFile);
+	}
+	return status;
+}
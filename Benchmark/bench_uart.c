@@ -0,0 +1,40 @@
+ /******************************************************************************
+ *
+ * Module: Benchmark
+ *
+ * File Name: bench_uart.c
+ *
+ * Description: UART benchmark firmware : time of UART_sendString until the last
+ *              frame left the shift register (bytes/s at BENCH_UART_BAUD_RATE)
+ *
+ * Author: Ganna Ahmed
+ *
+ *******************************************************************************/
+
+#include "bench.h"
+#include "UART.h"
+
+int main(void)
+{
+	UART_ConfigType config = {BENCH_UART_BAUD_RATE,eight,disabled,one};
+	uint8 str[BENCH_UART_BYTES];
+	uint8 i;
+
+	/* BENCH_UART_BYTES-1 characters , UART_sendString adds the '#' terminal */
+	for(i = 0 ; i < BENCH_UART_BYTES - 1 ; i++)
+	{
+		str[i] = 'A' + (i % 26);
+	}
+	str[BENCH_UART_BYTES - 1] = '\0';
+
+	UART_init(&config);
+	SET_BIT(UCSRA,TXC);    /* clear the transmit complete flag */
+
+	BENCH_BEGIN(BENCH_UART_SEND_STRING);
+	UART_sendString(str);
+	while(BIT_IS_CLEAR(UCSRA,TXC)){}
+	BENCH_END(BENCH_UART_SEND_STRING);
+
+	BENCH_exit();
+	return 0;
+}
@@ -0,0 +1,349 @@
+ /******************************************************************************
+ *
+ * Module: Fixed Point
+ *
+ * File Name: fixed_point.c
+ *
+ * Description: Source file of the fixed point math , the q16_16 functions use 16x16 bit
+ *              partial products and shift/subtract loops so no 64-bit multiplication or
+ *              division routine of the compiler library is linked
+ *
+ * Author: Ganna Ahmed
+ *
+ *******************************************************************************/
+
+#include "fixed_point.h"
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+q8_8 Q8_8_addSat(q8_8 a,q8_8 b)
+{
+	q8_8 sum = (q8_8)((uint16)a + (uint16)b);
+
+	/* overflow : both operands have the same sign and the sum has the other one */
+	if(((a ^ sum) & (b ^ sum)) < 0)
+	{
+		sum = (a < 0) ? Q8_8_MIN : Q8_8_MAX;
+	}
+	return sum;
+}
+
+q8_8 Q8_8_subSat(q8_8 a,q8_8 b)
+{
+	q8_8 diff = (q8_8)((uint16)a - (uint16)b);
+
+	/* overflow : the operands have different signs and the difference has the sign of b */
+	if(((a ^ b) & (a ^ diff)) < 0)
+	{
+		diff = (a < 0) ? Q8_8_MIN : Q8_8_MAX;
+	}
+	return diff;
+}
+
+q8_8 Q8_8_mulSat(q8_8 a,q8_8 b)
+{
+	sint32 product = ((sint32)a * b + 128)>>8;    /* rounded to the nearest step */
+
+	if(product > Q8_8_MAX)
+	{
+		return Q8_8_MAX;
+	}
+	if(product < Q8_8_MIN)
+	{
+		return Q8_8_MIN;
+	}
+	return (q8_8)product;
+}
+
+q16_16 Q16_16_addSat(q16_16 a,q16_16 b)
+{
+	q16_16 sum = (q16_16)((uint32)a + (uint32)b);
+
+	if(((a ^ sum) & (b ^ sum)) < 0)
+	{
+		sum = (a < 0) ? Q16_16_MIN : Q16_16_MAX;
+	}
+	return sum;
+}
+
+q16_16 Q16_16_subSat(q16_16 a,q16_16 b)
+{
+	q16_16 diff = (q16_16)((uint32)a - (uint32)b);
+
+	if(((a ^ b) & (a ^ diff)) < 0)
+	{
+		diff = (a < 0) ? Q16_16_MIN : Q16_16_MAX;
+	}
+	return diff;
+}
+
+ /******************************************************************************
+ *
+ * [Function name]: Q16_16_mulSat
+ *
+ * [Description]: multiplies the magnitudes as integer and fraction halves
+ *                (ai + af) * (bi + bf) = ai*bi + ai*bf + af*bi + af*bf
+ *                every partial product is a 16x16 bit multiplication , the result
+ *                is rounded to the nearest step and saturated
+ *
+ *******************************************************************************/
+q16_16 Q16_16_mulSat(q16_16 a,q16_16 b)
+{
+	uint8 negative = FALSE;
+	uint32 ua = (uint32)a;
+	uint32 ub = (uint32)b;
+	uint32 result;
+	uint32 part;
+
+	if(a < 0)
+	{
+		ua = 0 - ua;
+		negative = !negative;
+	}
+	if(b < 0)
+	{
+		ub = 0 - ub;
+		negative = !negative;
+	}
+
+	/* integer * integer must stay below 2^15 */
+	result = (uint32)(uint16)(ua>>16) * (uint16)(ub>>16);
+	if(result > 0x7FFF)
+	{
+		return negative ? Q16_16_MIN : Q16_16_MAX;
+	}
+	result <<= 16;
+
+	part = (uint32)(uint16)(ua>>16) * (uint16)ub;
+	result += part;
+	if(result < part)
+	{
+		return negative ? Q16_16_MIN : Q16_16_MAX;
+	}
+	part = (uint32)(uint16)ua * (uint16)(ub>>16);
+	result += part;
+	if(result < part)
+	{
+		return negative ? Q16_16_MIN : Q16_16_MAX;
+	}
+	part = ((uint32)(uint16)ua * (uint16)ub + 0x8000)>>16;
+	result += part;
+	if(result < part)
+	{
+		return negative ? Q16_16_MIN : Q16_16_MAX;
+	}
+
+	if(negative)
+	{
+		return (result >= 0x80000000UL) ? Q16_16_MIN : (q16_16)(0 - result);
+	}
+	return (result > 0x7FFFFFFFUL) ? Q16_16_MAX : (q16_16)result;
+}
+
+ /******************************************************************************
+ *
+ * [Function name]: Q8_8_reciprocal
+ *
+ * [Description]: 1/x = 2^16/raw , computed by a 16 steps shift/subtract division
+ *                (the dividend is a one followed by zeros) rounded to the nearest step
+ *
+ *******************************************************************************/
+q8_8 Q8_8_reciprocal(q8_8 x)
+{
+	uint16 divisor = (x < 0) ? (uint16)(0 - (uint16)x) : (uint16)x;
+	uint16 remainder = 1;
+	uint16 quotient = 0;
+	uint8 i;
+
+	/* |x| <= 2/256 : 1/x doesn't fit q8_8 */
+	if(divisor <= 2)
+	{
+		return (x < 0) ? Q8_8_MIN : Q8_8_MAX;
+	}
+	for(i = 0 ; i < 16 ; i++)
+	{
+		remainder <<= 1;
+		quotient <<= 1;
+		if(remainder >= divisor)
+		{
+			remainder -= divisor;
+			quotient |= 1;
+		}
+	}
+	if(remainder >= divisor - remainder)
+	{
+		quotient++;
+	}
+	return (x < 0) ? (q8_8)(0 - quotient) : (q8_8)quotient;
+}
+
+/* 1/x = 2^32/raw , same division with 32 steps */
+q16_16 Q16_16_reciprocal(q16_16 x)
+{
+	uint32 divisor = (x < 0) ? (0 - (uint32)x) : (uint32)x;
+	uint32 remainder = 1;
+	uint32 quotient = 0;
+	uint8 i;
+
+	if(divisor <= 2)
+	{
+		return (x < 0) ? Q16_16_MIN : Q16_16_MAX;
+	}
+	for(i = 0 ; i < 32 ; i++)
+	{
+		remainder <<= 1;
+		quotient <<= 1;
+		if(remainder >= divisor)
+		{
+			remainder -= divisor;
+			quotient |= 1;
+		}
+	}
+	if(remainder >= divisor - remainder)
+	{
+		quotient++;
+	}
+	return (x < 0) ? (q16_16)(0 - quotient) : (q16_16)quotient;
+}
+
+ /******************************************************************************
+ *
+ * [Function name]: FIX_isqrt32
+ *
+ * [Description]: integer square root (rounded down) , one result bit per step
+ *                using shifts , additions and subtractions only
+ *
+ *******************************************************************************/
+uint16 FIX_isqrt32(uint32 x)
+{
+	uint32 root = 0;
+	uint32 bit = 1UL<<30;
+
+	while(bit > x)
+	{
+		bit >>= 2;
+	}
+	while(bit != 0)
+	{
+		if(x >= root + bit)
+		{
+			x -= root + bit;
+			root = (root>>1) + bit;
+		}
+		else
+		{
+			root >>= 1;
+		}
+		bit >>= 2;
+	}
+	return (uint16)root;
+}
+
+/* sqrt(x) = sqrt(raw * 2^8) in q8_8 */
+q8_8 Q8_8_sqrt(q8_8 x)
+{
+	if(x <= 0)
+	{
+		return 0;
+	}
+	return (q8_8)FIX_isqrt32((uint32)x<<8);
+}
+
+ /******************************************************************************
+ *
+ * [Function name]: Q16_16_sqrt
+ *
+ * [Description]: sqrt(x) = sqrt(raw * 2^16) , the 48-bit radicand is taken two bits per
+ *                step (the 32 bits of raw then 16 zero bits) so the remainder and the
+ *                24-bit root stay in 32-bit variables
+ *
+ *******************************************************************************/
+q16_16 Q16_16_sqrt(q16_16 x)
+{
+	uint32 remainder = 0;
+	uint32 root = 0;
+	uint32 trial;
+	uint8 i;
+
+	if(x <= 0)
+	{
+		return 0;
+	}
+	for(i = 0 ; i < 24 ; i++)
+	{
+		remainder <<= 2;
+		if(i < 16)
+		{
+			remainder |= ((uint32)x>>(30 - 2 * i)) & 0x03;
+		}
+		root <<= 1;
+		trial = (root<<1) | 1;
+		if(remainder >= trial)
+		{
+			remainder -= trial;
+			root |= 1;
+		}
+	}
+	return (q16_16)root;
+}
+
+ /******************************************************************************
+ *
+ * [Function name]: FIX_lutInterpolate
+ *
+ * [Description]: finds the two points around x (index = (x - x0) >> shift) and
+ *                interpolates linearly between them
+ *
+ * [Args]: lut_Ptr: the table and its input range
+ *         x: input value (ADC counts , q8_8 , ...)
+ *
+ * [returns]: output value , the first (last) point below (above) the table range
+ *
+ *******************************************************************************/
+sint16 FIX_lutInterpolate(const FIX_LutType * lut_Ptr,sint16 x)
+{
+	uint16 offset;
+	uint16 index;
+	uint16 fraction;
+	sint16 y0;
+	sint16 y1;
+
+	if(x <= lut_Ptr->s_x0)
+	{
+		return (sint16)pgm_read_word(&lut_Ptr->s_table[0]);
+	}
+	offset = (uint16)x - (uint16)lut_Ptr->s_x0;
+	index = offset>>lut_Ptr->s_shift;
+	if(index >= lut_Ptr->s_points - 1)
+	{
+		return (sint16)pgm_read_word(&lut_Ptr->s_table[lut_Ptr->s_points - 1]);
+	}
+	fraction = offset & ((1U<<lut_Ptr->s_shift) - 1);
+	y0 = (sint16)pgm_read_word(&lut_Ptr->s_table[index]);
+	y1 = (sint16)pgm_read_word(&lut_Ptr->s_table[index + 1]);
+
+	return y0 + (sint16)((((sint32)y1 - y0) * fraction)>>lut_Ptr->s_shift);
+}
+
+/* counts * vref / 1024 rounded to the nearest millivolt */
+uint16 FIX_adcToMillivolts(uint16 counts,uint16 vref_mv)
+{
+	return (uint16)(((uint32)counts * vref_mv + 512)>>10);
+}
+
+sint16 FIX_scale(sint16 x,q8_8 gain,sint16 offset)
+{
+	sint32 result = (((sint32)x * gain + 128)>>8) + offset;
+
+	if(result > 32767)
+	{
+		return 32767;
+	}
+	if(result < -32768)
+	{
+		return -32768;
+	}
+	return (sint16)result;
+}
@@ -0,0 +1,99 @@
+ /******************************************************************************
+ *
+ * Module: Fixed Point
+ *
+ * File Name: fixed_point.h
+ *
+ * Description: header file of the fixed point math used to convert the sensor readings
+ *              (ADC counts) to voltages and engineering units with integer instructions
+ *              only , instead of the float32 software library
+ *              q8_8   : 16-bit signed , 8 fraction bits  (-128 to 127.996 , step 0.0039)
+ *              q16_16 : 32-bit signed , 16 fraction bits (-32768 to 32767.99998 , step 0.000015)
+ *
+ * Author: Ganna Ahmed
+ *
+ *******************************************************************************/
+
+#ifndef FIXED_POINT_H_
+#define FIXED_POINT_H_
+
+#include "std_types.h"
+#include "micro_configurations.h"
+#include <avr/pgmspace.h>
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef sint16 q8_8;
+typedef sint32 q16_16;
+
+/* Lookup table of a curve (thermistor , non linear sensor , ...) with equally spaced inputs:
+ * point i is at the input s_x0 + i * 2^s_shift , the power of 2 step needs no division */
+typedef struct
+{
+	const sint16 * s_table;    /* s_points output values stored in flash (PROGMEM) */
+	sint16 s_x0;               /* input of the first point */
+	uint8 s_shift;             /* step between two points is 2^s_shift (0 to 14) */
+	uint8 s_points;            /* number of points (at least 2) */
+}FIX_LutType;
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+#define Q8_8_ONE  ((q8_8)256)
+#define Q8_8_MAX  ((q8_8)0x7FFF)
+#define Q8_8_MIN  ((q8_8)(-0x7FFF - 1))
+
+#define Q16_16_ONE ((q16_16)65536L)
+#define Q16_16_MAX ((q16_16)0x7FFFFFFFL)
+#define Q16_16_MIN ((q16_16)(-0x7FFFFFFFL - 1))
+
+/* Constants from a real number (e.g. Q8_8_CONST(1.25)) , computed by the compiler so no float
+ * code is generated in case the argument is a constant */
+#define Q8_8_CONST(REAL) ((q8_8)((REAL) * 256.0 + (((REAL) >= 0) ? 0.5 : -0.5)))
+#define Q16_16_CONST(REAL) ((q16_16)((REAL) * 65536.0 + (((REAL) >= 0) ? 0.5 : -0.5)))
+
+/* Conversions (the integer part is rounded towards minus infinity) */
+#define Q8_8_FROM_INT(VALUE) ((q8_8)((VALUE) * 256))
+#define Q8_8_TO_INT(VALUE) ((sint16)((VALUE)>>8))
+#define Q16_16_FROM_INT(VALUE) ((q16_16)((sint32)(VALUE) * 65536L))
+#define Q16_16_TO_INT(VALUE) ((sint16)((VALUE)>>16))
+#define Q8_8_TO_Q16_16(VALUE) ((q16_16)(VALUE) * 256)
+#define Q16_16_TO_Q8_8(VALUE) ((q8_8)((VALUE)>>8))    /* the value must fit q8_8 */
+
+/* ADC counts (10 bits) to millivolts for a constant reference , with rounding */
+#define FIX_ADC_TO_MV(COUNTS,VREF_MV) ((uint16)(((uint32)(COUNTS) * (VREF_MV) + 512)>>10))
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/* Saturating arithmetic : the result is clamped to MIN/MAX instead of wrapping around */
+q8_8 Q8_8_addSat(q8_8 a,q8_8 b);
+q8_8 Q8_8_subSat(q8_8 a,q8_8 b);
+q8_8 Q8_8_mulSat(q8_8 a,q8_8 b);
+q16_16 Q16_16_addSat(q16_16 a,q16_16 b);
+q16_16 Q16_16_subSat(q16_16 a,q16_16 b);
+q16_16 Q16_16_mulSat(q16_16 a,q16_16 b);
+
+/* 1/x , saturated for x = 0 and for the results out of range */
+q8_8 Q8_8_reciprocal(q8_8 x);
+q16_16 Q16_16_reciprocal(q16_16 x);
+
+/* Square roots (0 for negative values) */
+uint16 FIX_isqrt32(uint32 x);
+q8_8 Q8_8_sqrt(q8_8 x);
+q16_16 Q16_16_sqrt(q16_16 x);
+
+/* Linear interpolation between the two points around x , clamped to the first and last points */
+sint16 FIX_lutInterpolate(const FIX_LutType * lut_Ptr,sint16 x);
+
+/* ADC counts (10 bits) to millivolts for a reference measured at run time */
+uint16 FIX_adcToMillivolts(uint16 counts,uint16 vref_mv);
+
+/* gain * x + offset , gain in q8_8 (e.g. 0.1 degree per millivolt of an LM35) , saturated to sint16 */
+sint16 FIX_scale(sint16 x,q8_8 gain,sint16 offset);
+
+#endif /* FIXED_POINT_H_ */
@@ -4,28 +4,191 @@
  *
  * File Name: keypad.c
  *
- * Description: source file for keypad driver (4x3 or 4x4 keypad)
+ * Description: source file for keypad driver (up to 8x8 keypad)
  *
  * Author: Ganna Ahmed
  *
  *******************************************************************************/
 
 #include"keypad.h"
+#include"ring_buffer.h"
 
-#if (N_col == 3)
-/*
- * Function responsible for mapping the switch number in the keypad to
- * its corresponding functional number in the proteus for 4x3 keypad
- */
-static uint8 KeyPad_4x3_adjustKeyNumber(uint8 button_number);
-#elif (N_col == 4)
-/*
- * Function responsible for mapping the switch number in the keypad to
- * its corresponding functional number in the proteus for 4x4 keypad
- */
-static uint8 KeyPad_4x4_adjustKeyNumber(uint8 button_number);
+/* Port pins of the rows and the columns */
+#define KEYPAD_ROW_MASK ((uint8)(((1<<N_row) - 1)<<KEYPAD_FIRST_ROW_PIN))
+#define KEYPAD_COL_MASK ((uint8)(((1<<N_col) - 1)<<KEYPAD_FIRST_COL_PIN))
+
+#ifdef KEYPAD_WAKE
+/* Pin , enable bit , flag and vector of the wake up external interrupt */
+#if (KEYPAD_WAKE_INT == 0)
+#define KEYPAD_INT_PORT_OUT PORTD
+#define KEYPAD_INT_PORT_DIR DDRD
+#define KEYPAD_INT_PORT_IN PIND
+#define KEYPAD_INT_PIN PD2
+#define KEYPAD_INT_ENABLE INT0
+#define KEYPAD_INT_FLAG INTF0
+#define KEYPAD_INT_VECT INT0_vect
+#elif (KEYPAD_WAKE_INT == 1)
+#define KEYPAD_INT_PORT_OUT PORTD
+#define KEYPAD_INT_PORT_DIR DDRD
+#define KEYPAD_INT_PORT_IN PIND
+#define KEYPAD_INT_PIN PD3
+#define KEYPAD_INT_ENABLE INT1
+#define KEYPAD_INT_FLAG INTF1
+#define KEYPAD_INT_VECT INT1_vect
+#elif (KEYPAD_WAKE_INT == 2)
+#define KEYPAD_INT_PORT_OUT PORTB
+#define KEYPAD_INT_PORT_DIR DDRB
+#define KEYPAD_INT_PORT_IN PINB
+#define KEYPAD_INT_PIN PB2
+#define KEYPAD_INT_ENABLE INT2
+#define KEYPAD_INT_FLAG INTF2
+#define KEYPAD_INT_VECT INT2_vect
+#else
+#error "Keypad wake up interrupt must be 0 , 1 or 2"
+#endif
+#endif
+
+#ifndef KEYPAD_CUSTOM_KEYMAP
+#if (KEYPAD_LAYERS != 1)
+#error "The built in keymaps have one layer"
+#endif
+
+#if (N_row == 4) && (N_col == 3)
+const uint8 g_keypadKeymap[KEYPAD_LAYERS][N_row][N_col] PROGMEM =
+{
+	{
+		{1,2,3},
+		{4,5,6},
+		{7,8,9},
+		{'*',0,'#'}
+	}
+};
+#elif (N_row == 4) && (N_col == 4)
+const uint8 g_keypadKeymap[KEYPAD_LAYERS][N_row][N_col] PROGMEM =
+{
+	{
+		{7,8,9,'%'},
+		{4,5,6,'*'},
+		{1,2,3,'-'},
+		{13,0,'=','+'}    /* 13 is the ASCII of Enter */
+	}
+};
+#else
+#error "No built in keymap for this keypad size , define KEYPAD_CUSTOM_KEYMAP and g_keypadKeymap"
+#endif
+#endif
+
+/*** Global Variables ***/
+
+/* Keymap layer used to translate the keys */
+static uint8 g_keypadLayer = 0;
+
+/*** Private Functions ***/
+
+static void keypad_driveColumn(uint8 col);
+static uint8 keypad_keyValue(uint8 key_index);
+
+#ifdef KEYPAD_SCAN
+/* Debounce states of a key */
+#define KEY_RELEASED 0
+#define KEY_PRESS_DEBOUNCE 1
+#define KEY_PRESSED 2
+#define KEY_RELEASE_DEBOUNCE 3
+
+/* The matrix is processed once every scan cycle (all columns sampled) */
+#define KEYPAD_CYCLE_MS (KEYPAD_SCAN_TICK_MS*N_col)
+#define KEYPAD_LONG_PRESS_CYCLES (KEYPAD_LONG_PRESS_MS/KEYPAD_CYCLE_MS)
+#define KEYPAD_REPEAT_DELAY_CYCLES (KEYPAD_REPEAT_DELAY_MS/KEYPAD_CYCLE_MS)
+#define KEYPAD_REPEAT_RATE_CYCLES (KEYPAD_REPEAT_RATE_MS/KEYPAD_CYCLE_MS)
+
+#if ((KEYPAD_LONG_PRESS_CYCLES > 65535) || (KEYPAD_REPEAT_DELAY_CYCLES > 65535))
+#error "Keypad long press and repeat times must be at most 65535 scan cycles"
+#endif
+
+#if (KEYPAD_REPEAT_RATE_CYCLES > KEYPAD_REPEAT_DELAY_CYCLES)
+#error "Keypad repeat rate time must not exceed the repeat delay time"
+#endif
+
+/* Event queue from keypad_scan (producer) to keypad_getEvent (consumer) */
+RING_BUFFER_DEFINE(keypadQueue,keypad_EventType,KEYPAD_EVENT_QUEUE_SIZE)
+
+typedef struct
+{
+	uint8 s_state;
+	uint8 s_samples;	/* consecutive samples at the new level */
+	uint16 s_held;		/* cycles since the press was accepted (saturates at the long press time) */
+	uint16 s_repeat;	/* cycles towards the next repeat event , kept when a release bounces */
+}keypad_KeyType;
+
+/*** Global Variables ***/
+
+static keypad_KeyType g_keys[N_row*N_col];
+
+static keypadQueue_RingType g_keypadQueue;
+
+/* Column driven low since the previous keypad_scan call */
+static uint8 g_scanColumn = 0;
+
+/* Closed keys of the current scan cycle , bit n of entry col is the key of row n */
+static uint8 g_scanMatrix[N_col];
+
+/* Debounced pressed keys in the same layout */
+static volatile uint8 g_pressedMatrix[N_col];
+
+#ifdef KEYPAD_WAKE
+/* Copy of the scan timer configuration to restart the timer on wake up */
+static timer_ConfigType g_scanTimer;
+
+/* TRUE while all keys are released and the keypad waits for the external interrupt */
+static volatile uint8 g_keypadIdle = FALSE;
+#endif
+
+/*** Private Functions ***/
+
+static void keypad_pushEvent(uint8 key_index,keypad_event event);
+static void keypad_updateKey(uint8 key_index,uint8 pressed);
+static void keypad_updateHeldKey(uint8 key_index);
+static void keypad_processMatrix(void);
+#endif
+
+#ifdef KEYPAD_WAKE
+static uint8 keypad_isActive(void);
+static void keypad_enterIdle(void);
+static void keypad_wake(void);
 #endif
 
+/*************************************************************************************************
+ *  [Function Name]:    keypad_driveColumn
+ *  [Description] :		This Function drives one column low and the other columns in high impedance
+ *                      and sets the rows as inputs with their pull up resistors enabled
+ *  [Args] :            uint8 col
+ *  [Returns] :			NONE
+ ***************************************************************************************************/
+
+static void keypad_driveColumn(uint8 col)
+{
+	KEYPAD_ROW_PORT_DIR &= (uint8)~KEYPAD_ROW_MASK;
+	KEYPAD_ROW_PORT_OUT |= KEYPAD_ROW_MASK;
+
+	KEYPAD_COL_PORT_OUT &= (uint8)~KEYPAD_COL_MASK;
+	KEYPAD_COL_PORT_DIR = (KEYPAD_COL_PORT_DIR & (uint8)~KEYPAD_COL_MASK) | (1<<(KEYPAD_FIRST_COL_PIN+col));
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    keypad_keyValue
+ *  [Description] :		This Function reads the value of a key from the keymap of the current layer
+ *                      (constant time lookup in flash)
+ *  [Args] :            uint8 key_index
+ *                         index of the key (row*N_col+col)
+ *  [Returns] :			uint8
+ *                         key value
+ ***************************************************************************************************/
+
+static uint8 keypad_keyValue(uint8 key_index)
+{
+	return pgm_read_byte(&g_keypadKeymap[g_keypadLayer][0][0] + key_index);
+}
+
 uint8 keypad_getPressedKey(void){
 
 	uint8 row,col;
@@ -33,83 +196,445 @@ uint8 keypad_getPressedKey(void){
 	{
 		for(col=0;col<N_col;col++)
 		{
-			KEYPAD_PORT_DIR=(0b00010000<<col);
-			KEYPAD_PORT_OUT = (~(0b00010000<<col));
+			keypad_driveColumn(col);
 
 			for(row=0;row<N_row;row++)
-				if(BIT_IS_CLEAR(KEYPAD_PORT_IN,row)){
+				if(BIT_IS_CLEAR(KEYPAD_ROW_PORT_IN,(row+KEYPAD_FIRST_ROW_PIN))){
 				    _delay_ms(50);
-				    if(BIT_IS_CLEAR(KEYPAD_PORT_IN, row)){
+				    if(BIT_IS_CLEAR(KEYPAD_ROW_PORT_IN,(row+KEYPAD_FIRST_ROW_PIN))){
 				    	_delay_ms(170);
-
-                        #if(N_col==3)
-					       return KeyPad_4x3_adjustKeyNumber((row*N_col)+col+1);
-                        #elif(N_col==4)
-					       return KeyPad_4x4_adjustKeyNumber((row*N_col)+col+1);
-                        #endif
-				}
+				    	return keypad_keyValue((row*N_col)+col);
+				    }
 				}
+		}
+	}
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    keypad_setLayer
+ *  [Description] :		This Function selects the keymap layer used for the next returned keys
+ *                      (for example the application selects the shift layer on the press event
+ *                      of its shift key and layer 0 on its release event)
+ *  [Args] :            uint8 layer
+ *                         0 to KEYPAD_LAYERS-1
+ *  [Returns] :			uint8
+ *                         ERROR in case of invalid layer
+ *                         SUCCESS otherwise
+ ***************************************************************************************************/
+
+uint8 keypad_setLayer(uint8 layer)
+{
+	if(layer >= KEYPAD_LAYERS)
+		return ERROR;
+
+	g_keypadLayer = layer;
+	return SUCCESS;
+}
+
+
+#ifdef KEYPAD_SCAN
+/*************************************************************************************************
+ *  [Function Name]:    keypad_pushEvent
+ *  [Description] :		This Function queues an event, the event is dropped if the queue is full
+ *  [Args] :            uint8 key_index
+ *                         index of the key (row*N_col+col)
+ *                      keypad_event event
+ *  [Returns] :			NONE
+ ***************************************************************************************************/
+
+static void keypad_pushEvent(uint8 key_index,keypad_event event)
+{
+	keypad_EventType entry;
 
+	/* the key value is taken from the layer active when the event happened , so the press and
+	 * the release of a key report the same value even if the layer changes in between */
+	entry.s_key = keypad_keyValue(key_index);
+	entry.s_event = event;
+	keypadQueue_push(&g_keypadQueue,&entry);
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    keypad_updateKey
+ *  [Description] :		This Function advances the debounce state machine of a key with a new sample,
+ *                      a press or a release is accepted after KEYPAD_DEBOUNCE_SAMPLES consecutive
+ *                      samples at the new level and a sample at the old level cancels it
+ *  [Args] :            uint8 key_index
+ *                         index of the key (row*N_col+col)
+ *                      uint8 pressed
+ *                         TRUE if the key is closed in this sample
+ *  [Returns] :			NONE
+ ***************************************************************************************************/
+
+static void keypad_updateKey(uint8 key_index,uint8 pressed)
+{
+	keypad_KeyType * key = &g_keys[key_index];
+
+	switch(key->s_state)
+	{
+	case KEY_RELEASED:
+		if(pressed){
+			key->s_state = KEY_PRESS_DEBOUNCE;
+			key->s_samples = 1;
+		}
+		break;
+	case KEY_PRESS_DEBOUNCE:
+		if(!pressed){
+			key->s_state = KEY_RELEASED;	/* bounce or noise */
+		}
+		else if(++key->s_samples >= KEYPAD_DEBOUNCE_SAMPLES){
+			key->s_state = KEY_PRESSED;
+			key->s_held = 0;
+			key->s_repeat = 0;
+			keypad_pushEvent(key_index,KEYPAD_PRESS);
+		}
+		break;
+	case KEY_PRESSED:
+		if(!pressed){
+			key->s_state = KEY_RELEASE_DEBOUNCE;
+			key->s_samples = 1;
+		}
+		else{
+			keypad_updateHeldKey(key_index);
+		}
+		break;
+	case KEY_RELEASE_DEBOUNCE:
+		if(pressed){
+			key->s_state = KEY_PRESSED;	/* bounce , the hold and repeat times go on */
+		}
+		else if(++key->s_samples >= KEYPAD_DEBOUNCE_SAMPLES){
+			key->s_state = KEY_RELEASED;
+			keypad_pushEvent(key_index,KEYPAD_RELEASE);
+		}
+		break;
+	}
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    keypad_updateHeldKey
+ *  [Description] :		This Function counts the hold time of a pressed key and queues its long press
+ *                      event (once) and its auto repeat events (first after KEYPAD_REPEAT_DELAY_MS
+ *                      then every KEYPAD_REPEAT_RATE_MS)
+ *  [Args] :            uint8 key_index
+ *                         index of the key (row*N_col+col)
+ *  [Returns] :			NONE
+ ***************************************************************************************************/
+
+static void keypad_updateHeldKey(uint8 key_index)
+{
+	keypad_KeyType * key = &g_keys[key_index];
+
+#if (KEYPAD_LONG_PRESS_CYCLES > 0)
+	if(key->s_held < KEYPAD_LONG_PRESS_CYCLES){
+		key->s_held++;
+		if(key->s_held == KEYPAD_LONG_PRESS_CYCLES){
+			keypad_pushEvent(key_index,KEYPAD_LONG_PRESS);
+		}
+	}
+#endif
+
+#if (KEYPAD_REPEAT_DELAY_CYCLES > 0)
+	key->s_repeat++;
+	if(key->s_repeat >= KEYPAD_REPEAT_DELAY_CYCLES){
+		keypad_pushEvent(key_index,KEYPAD_REPEAT);
+		/* the next repeat comes after KEYPAD_REPEAT_RATE_CYCLES */
+		key->s_repeat = KEYPAD_REPEAT_DELAY_CYCLES - KEYPAD_REPEAT_RATE_CYCLES;
+	}
+#endif
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    keypad_processMatrix
+ *  [Description] :		This Function updates all keys with the matrix of a complete scan cycle
+ *                      Without diodes three closed keys on the corners of a rectangle close the
+ *                      fourth corner too (ghost key), so when two columns share two or more closed
+ *                      rows the keys of those rows and columns are ambiguous and keep their state
+ *                      until the matrix is unambiguous again
+ *  [Args] :            NONE
+ *  [Returns] :			NONE
+ ***************************************************************************************************/
+
+static void keypad_processMatrix(void)
+{
+	uint8 row,col,col2;
+	uint8 common;
+	uint8 pressed;
+	uint8 ambiguous[N_col] = {0};
+
+	for(col=0;col<N_col;col++)
+	{
+		for(col2=col+1;col2<N_col;col2++)
+		{
+			common = g_scanMatrix[col] & g_scanMatrix[col2];
+			/* more than one bit set */
+			if(common & (common - 1)){
+				ambiguous[col] |= common;
+				ambiguous[col2] |= common;
 			}
+		}
+	}
 
+	for(col=0;col<N_col;col++)
+	{
+		for(row=0;row<N_row;row++)
+		{
+			if(BIT_IS_CLEAR(ambiguous[col],row)){
+				keypad_updateKey((row*N_col)+col,BIT_IS_SET(g_scanMatrix[col],row) ? TRUE : FALSE);
+			}
+		}
+		/* a key is pressed until its release is accepted */
+		pressed = 0;
+		for(row=0;row<N_row;row++)
+		{
+			if(g_keys[(row*N_col)+col].s_state >= KEY_PRESSED){
+				SET_BIT(pressed,row);
+			}
 		}
+		g_pressedMatrix[col] = pressed;
 	}
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    keypad_scanInit
+ *  [Description] :		This Function initializes the non blocking keypad scan
+ *                      1-Release all keys and empty the event queue
+ *                      2-Drive the first column
+ *                      3-Set keypad_scan as the timer call back function (run time binding only)
+ *                        and initialize the timer
+ *  [Args] :            Pointer to Struct timer_ConfigType
+ *                         timer configuration, its interrupt period must be KEYPAD_SCAN_TICK_MS
+ *  [Returns] :			NONE
+ *  [Remarks] :         In case of compile time binding of timer call backs call keypad_scan
+ *                      from the hook of the timer interrupt
+ *                      keypad_getPressedKey must not be used while the scan is running
+ *                      In wake mode the scan goes idle after the first cycle without pressed keys
+ ***************************************************************************************************/
 
+void keypad_scanInit(const timer_ConfigType * config_Ptr)
+{
+	uint8 key_index;
 
-#if(N_col==3)
-static uint8 KeyPad_4x3_adjustKeyNumber(uint8 button_number){
-	switch(button_number)
+	for(key_index=0;key_index<(N_row*N_col);key_index++)
 	{
-	   case '10':return'*';
-	             break;
-	   case '11':return 0;
-	             break;
-	   case '12':return '#';
-	             break;
-	   default: return button_number;
+		g_keys[key_index].s_state = KEY_RELEASED;
+	}
+	for(key_index=0;key_index<N_col;key_index++)
+	{
+		g_pressedMatrix[key_index] = 0;
+	}
+	keypadQueue_init(&g_keypadQueue);
+	g_scanColumn = 0;
+	keypad_driveColumn(0);
+
+#ifdef KEYPAD_WAKE
+	g_scanTimer = *config_Ptr;
+	g_keypadIdle = FALSE;
+
+	/* Interrupt pin is an input with pull up , it is pulled low through the diode of a closed row */
+	CLEAR_BIT(KEYPAD_INT_PORT_DIR,KEYPAD_INT_PIN);
+	SET_BIT(KEYPAD_INT_PORT_OUT,KEYPAD_INT_PIN);
+
+	/* INT0 and INT1 low level (the only sense waking up from power down) , INT2 falling edge */
+#if (KEYPAD_WAKE_INT == 0)
+	MCUCR &= ~((1<<ISC01) | (1<<ISC00));
+#elif (KEYPAD_WAKE_INT == 1)
+	MCUCR &= ~((1<<ISC11) | (1<<ISC10));
+#else
+	CLEAR_BIT(MCUCSR,ISC2);
+#endif
+	CLEAR_BIT(GICR,KEYPAD_INT_ENABLE);
+#endif
 
+#ifndef TIMER_STATIC_CALLBACK
+	if(config_Ptr->s_timerType==0){
+		timer0_setCallBack(keypad_scan);
+	}
+	else if(config_Ptr->s_timerType==1){
+		timer1_setCallBack(keypad_scan);
+	}
+	else if(config_Ptr->s_timerType==2){
+		timer2_setCallBack(keypad_scan);
 	}
+#endif
+
+	timer_init(config_Ptr);
 }
 
-#elif(N_col==4)
-static uint8 KeyPad_4x4_adjustKeyNumber(uint8 button_number){
-	switch(button_number)
+/*************************************************************************************************
+ *  [Function Name]:    keypad_scan
+ *  [Description] :		This Function samples the rows of the column driven in the previous call then
+ *                      drives the next column (the column has a whole tick to settle so no delay is
+ *                      needed), after the last column the whole matrix is processed so any number
+ *                      of keys can be pressed together
+ *  [Args] :            NONE
+ *  [Returns] :			NONE
+ *  [Remarks] :         Every key is sampled once every N_col calls
+ ***************************************************************************************************/
+
+void keypad_scan(void)
+{
+	/* rows are active low */
+	g_scanMatrix[g_scanColumn] = ((uint8)(~KEYPAD_ROW_PORT_IN) & KEYPAD_ROW_MASK)>>KEYPAD_FIRST_ROW_PIN;
+
+	g_scanColumn++;
+	if(g_scanColumn == N_col){
+		g_scanColumn = 0;
+		keypad_processMatrix();
+
+#ifdef KEYPAD_WAKE
+		if(!keypad_isActive()){
+			keypad_enterIdle();
+			return;
+		}
+#endif
+	}
+	keypad_driveColumn(g_scanColumn);
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    keypad_getEvent
+ *  [Description] :		This Function takes the oldest key event from the queue without waiting
+ *                      (the key value is the one of the layer active when the event happened)
+ *  [Args] :            Pointer to Struct keypad_EventType
+ *                         filled with the key value and the event
+ *  [Returns] :			uint8
+ *                         ERROR in case no event is queued
+ *                         SUCCESS otherwise
+ ***************************************************************************************************/
+
+uint8 keypad_getEvent(keypad_EventType * event_Ptr)
+{
+	return keypadQueue_pop(&g_keypadQueue,event_Ptr);
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    keypad_isKeyPressed
+ *  [Description] :		This Function checks the debounced state of a key (used to test key combinations)
+ *  [Args] :            uint8 row
+ *                      uint8 col
+ *  [Returns] :			uint8
+ *                         TRUE if the key is pressed , FALSE otherwise
+ ***************************************************************************************************/
+
+uint8 keypad_isKeyPressed(uint8 row,uint8 col)
+{
+	if((row >= N_row) || (col >= N_col))
+		return FALSE;
+
+	return BIT_IS_SET(g_pressedMatrix[col],row) ? TRUE : FALSE;
+}
+#endif
+
+#ifdef KEYPAD_WAKE
+/*************************************************************************************************
+ *  [Function Name]:    keypad_isActive
+ *  [Description] :		This Function checks if any key is pressed or being debounced
+ *  [Args] :            NONE
+ *  [Returns] :			uint8
+ *                         TRUE if a key is not in the released state , FALSE otherwise
+ ***************************************************************************************************/
+
+static uint8 keypad_isActive(void)
+{
+	uint8 key_index;
+
+	for(key_index=0;key_index<(N_row*N_col);key_index++)
 	{
-	case 1: return 7;
-			break;
-	case 2: return 8;
-			break;
-	case 3: return 9;
-			break;
-	case 4: return '%'; // ASCII Code of %
-			break;
-	case 5: return 4;
-			break;
-	case 6: return 5;
-			break;
-	case 7: return 6;
-			break;
-	case 8: return '*'; /* ASCII Code of '*' */
-			break;
-	case 9: return 1;
-			break;
-	case 10: return 2;
-			break;
-	case 11: return 3;
-			break;
-	case 12: return '-'; /* ASCII Code of '-' */
-			break;
-	case 13: return 13;  /* ASCII of Enter */
-			break;
-	case 14: return 0;
-			break;
-	case 15: return '='; /* ASCII Code of '=' */
-			break;
-	case 16: return '+'; /* ASCII Code of '+' */
-			break;
-	default: return button_number;
+		if(g_keys[key_index].s_state != KEY_RELEASED)
+			return TRUE;
+	}
+	return FALSE;
 }
 
+/*************************************************************************************************
+ *  [Function Name]:    keypad_enterIdle
+ *  [Description] :		This Function stops the scan timer , drives all columns low so any press pulls
+ *                      the interrupt pin low and enables the external interrupt
+ *  [Args] :            NONE
+ *  [Returns] :			NONE
+ ***************************************************************************************************/
+
+static void keypad_enterIdle(void)
+{
+	timer_stop(g_scanTimer.s_timerType);
+	g_keypadIdle = TRUE;
+
+	KEYPAD_COL_PORT_OUT &= (uint8)~KEYPAD_COL_MASK;
+	KEYPAD_COL_PORT_DIR |= KEYPAD_COL_MASK;
+
+	/* Clear an old request (flag is cleared by writing one) then enable the interrupt */
+	GIFR = (1<<KEYPAD_INT_FLAG);
+	SET_BIT(GICR,KEYPAD_INT_ENABLE);
+
+#if (KEYPAD_WAKE_INT == 2)
+	/* A key closed before the interrupt was enabled gives no falling edge */
+	if(BIT_IS_CLEAR(KEYPAD_INT_PORT_IN,KEYPAD_INT_PIN)){
+		keypad_wake();
+	}
 #endif
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    keypad_wake
+ *  [Description] :		This Function disables the external interrupt and restarts the scan from the
+ *                      first column
+ *  [Args] :            NONE
+ *  [Returns] :			NONE
+ ***************************************************************************************************/
+
+static void keypad_wake(void)
+{
+	CLEAR_BIT(GICR,KEYPAD_INT_ENABLE);	/* the low level interrupt would fire again */
+	g_keypadIdle = FALSE;
+	g_scanColumn = 0;
+	keypad_driveColumn(0);
+	timer_init(&g_scanTimer);
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    keypad_isIdle
+ *  [Description] :		This Function checks if the keypad waits for a press with the scan timer stopped
+ *  [Args] :            NONE
+ *  [Returns] :			uint8
+ *                         TRUE if the keypad is idle , FALSE otherwise
+ ***************************************************************************************************/
+
+uint8 keypad_isIdle(void)
+{
+	return g_keypadIdle;
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    keypad_sleep
+ *  [Description] :		This Function puts the MCU in KEYPAD_SLEEP_MODE if the keypad is idle and all
+ *                      events were read , the MCU wakes up on the next key press (or any other
+ *                      enabled interrupt)
+ *  [Args] :            NONE
+ *  [Returns] :			NONE
+ *  [Remarks] :         Call it from the main loop with the interrupts enabled
+ ***************************************************************************************************/
+
+void keypad_sleep(void)
+{
+	set_sleep_mode(KEYPAD_SLEEP_MODE);
+
+	/* The check and the sleep instruction must not be separated by the wake up interrupt */
+	cli();
+	if(g_keypadIdle && (keypadQueue_count(&g_keypadQueue) == 0))
+	{
+		sleep_enable();
+		sei();		/* the instruction after sei is executed before any pending interrupt */
+		sleep_cpu();
+		sleep_disable();
 	}
+	sei();
+}
 
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+
+ISR(KEYPAD_INT_VECT)
+{
+	keypad_wake();
+}
+#endif
@@ -21,15 +21,108 @@
 #define N_col 4
 #define N_row 4
 
-/* Keypad Port Configurations */
-#define KEYPAD_PORT_OUT PORTC
-#define KEYPAD_PORT_IN  PINC
-#define KEYPAD_PORT_DIR DDRC
+/* Keypad Port Configurations , rows are inputs with pull ups and columns are driven low
+ * one at a time (rows and columns may share the same port) */
+#define KEYPAD_ROW_PORT_OUT PORTC
+#define KEYPAD_ROW_PORT_IN  PINC
+#define KEYPAD_ROW_PORT_DIR DDRC
+#define KEYPAD_FIRST_ROW_PIN 0     /* rows use N_row consecutive pins starting from this pin */
+#define KEYPAD_COL_PORT_OUT PORTC
+#define KEYPAD_COL_PORT_DIR DDRC
+#define KEYPAD_FIRST_COL_PIN 4     /* columns use N_col consecutive pins starting from this pin */
+
+#if ((KEYPAD_FIRST_ROW_PIN + N_row) > 8) || ((KEYPAD_FIRST_COL_PIN + N_col) > 8)
+#error "Keypad rows and columns must fit in their ports (up to 8x8)"
+#endif
+
+/* Custom keymap: the application defines the key values table
+ * const uint8 g_keypadKeymap[KEYPAD_LAYERS][N_row][N_col] PROGMEM = {...};
+ * otherwise the built in keymap of the 4x3 (phone) or 4x4 (calculator) keypad is used */
+#define KEYPAD_CUSTOM_KEYMAP
+#undef KEYPAD_CUSTOM_KEYMAP  /* Remove This line in case you want to use your own keymap */
+
+#define KEYPAD_LAYERS 1    /* number of keymap layers (shift , fn , ...) , 1 for the built in keymaps */
+
+/* Scan mode: keypad_scan is called periodically (timer interrupt) and it debounces every key
+ * and queues the press and release events, keypad_getEvent returns immediately */
+#define KEYPAD_SCAN
+#undef KEYPAD_SCAN  /* Remove This line in case you want to use the non blocking scan */
+
+#define KEYPAD_SCAN_TICK_MS 1        /* period of keypad_scan calls , one column is scanned per call */
+#define KEYPAD_DEBOUNCE_SAMPLES 5    /* same level samples needed to accept a change (every N_col ticks) */
+#define KEYPAD_EVENT_QUEUE_SIZE 8    /* number of queued events (power of 2 up to 128) */
+#define KEYPAD_LONG_PRESS_MS 800     /* hold time of a long press event (0 to disable) */
+#define KEYPAD_REPEAT_DELAY_MS 500   /* hold time of the first repeat event (0 to disable auto repeat) */
+#define KEYPAD_REPEAT_RATE_MS 100    /* time between the next repeat events */
+
+/* Wake mode (scan mode only): when all keys are released the columns are all driven low, the scan
+ * timer is stopped and a press wakes the MCU from sleep through an external interrupt , every row
+ * is connected to the interrupt pin through a diode (cathode on the row side)
+ * The scan timer must be used by the keypad only in this mode */
+#define KEYPAD_WAKE
+#undef KEYPAD_WAKE  /* Remove This line in case you want to use the interrupt wake up */
+
+/* the external interrupt KEYPAD_WAKE_INT is chosen in micro_configurations.h */
+#define KEYPAD_SLEEP_MODE SLEEP_MODE_PWR_DOWN    /* sleep mode used by keypad_sleep */
+
+#if (defined(KEYPAD_WAKE) && !defined(KEYPAD_SCAN))
+#error "Keypad wake mode needs the scan mode"
+#endif
+
+#ifdef KEYPAD_SCAN
+#include "timers.h"
+#endif
+
+#ifdef KEYPAD_WAKE
+#include <avr/sleep.h>
+#endif
+
+#include <avr/pgmspace.h>
+
+#define ERROR 0
+#define SUCCESS 1
+
+#ifdef KEYPAD_SCAN
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef enum
+{
+	KEYPAD_PRESS,KEYPAD_RELEASE,KEYPAD_LONG_PRESS,KEYPAD_REPEAT
+}keypad_event;
+
+typedef struct
+{
+	uint8 s_key;            /* key value (same values returned by keypad_getPressedKey) */
+	keypad_event s_event;
+}keypad_EventType;
+#endif
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Key values of every layer , stored in flash */
+extern const uint8 g_keypadKeymap[KEYPAD_LAYERS][N_row][N_col] PROGMEM;
 
 /*******************************************************************************
  *                      Functions Prototypes                                   *
  *******************************************************************************/
 
 uint8 keypad_getPressedKey(void);
+uint8 keypad_setLayer(uint8 layer);
+
+#ifdef KEYPAD_SCAN
+void keypad_scanInit(const timer_ConfigType * config_Ptr);
+void keypad_scan(void);
+uint8 keypad_getEvent(keypad_EventType * event_Ptr);
+uint8 keypad_isKeyPressed(uint8 row,uint8 col);
+#endif
+
+#ifdef KEYPAD_WAKE
+uint8 keypad_isIdle(void);
+void keypad_sleep(void);
+#endif
 
 #endif /* KEYPAD_H_ */
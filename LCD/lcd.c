@@ -11,6 +11,355 @@
  *******************************************************************************/
 
 #include "lcd.h"
+#ifdef LCD_ASYNC
+#include "ring_buffer.h"
+#endif
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Bus timings of the HD44780 (from data sheet) in micro seconds, _delay_us converts
+ * them to cycles using F_CPU so they are never shorter than required */
+#define LCD_T_AS_US   0.06    /* address (RS,RW) set up time before E rises : 40ns */
+#define LCD_T_PW_US   0.45    /* enable pulse width : 230ns , data delay time for reading : 360ns */
+#define LCD_T_H_US    0.55    /* hold time + rest of enable cycle time (1000ns) after E falls */
+
+/* Execution times used when the busy flag is not read (from data sheet at 270KHz + margin) */
+#define LCD_EXEC_US        50    /* most commands and data write : 37us */
+#define LCD_LONG_EXEC_US   2000  /* clear display and return home : 1.52ms */
+
+/* Maximum number of busy flag reads before giving up (LCD not connected) */
+#define LCD_BUSY_TIMEOUT   2000
+
+#ifdef LCD_ASYNC
+/* Extra ticks to wait after an operation when the busy flag is not read (the next tick is one period later) */
+#define LCD_EXEC_TICKS       ((LCD_EXEC_US + LCD_ASYNC_TICK_US - 1) / LCD_ASYNC_TICK_US - 1)
+#define LCD_LONG_EXEC_TICKS  ((LCD_LONG_EXEC_US + LCD_ASYNC_TICK_US - 1) / LCD_ASYNC_TICK_US - 1)
+#endif
+
+/* Biggest field width of the display number functions and the size of their string */
+#define LCD_FORMAT_MAX_WIDTH 16
+#define LCD_FORMAT_BUFFER_SIZE (LCD_FORMAT_MAX_WIDTH + 1)
+
+/* LCD pins and state access: taken from the handle in case of multi display mode , otherwise
+ * they are constants so every pin change compiles to a single bit set/clear instruction */
+#ifdef LCD_MULTI_DISPLAY
+#define LCD_CTRL_OUT        (*lcd_Ptr->s_ctrlPort)
+#define LCD_CTRL_DIR        (*lcd_Ptr->s_ctrlPortDir)
+#define LCD_DATA_OUT        (*lcd_Ptr->s_dataPort)
+#define LCD_DATA_DIR        (*lcd_Ptr->s_dataPortDir)
+#define LCD_DATA_IN         (*lcd_Ptr->s_dataPortIn)
+#define LCD_RS_MASK         (lcd_Ptr->s_rsMask)
+#define LCD_RW_MASK         (lcd_Ptr->s_rwMask)
+#define LCD_E_MASK          (lcd_Ptr->s_enableMask)
+#define LCD_IS_4_BITS       (lcd_Ptr->s_dataBitsMode == 4)
+#define LCD_IS_UPPER_PINS   (lcd_Ptr->s_upperPortPins)
+#define LCD_COLUMNS         (lcd_Ptr->s_cols)
+#define LCD_GLYPH_RESIDENT  (lcd_Ptr->s_glyphResident)
+#define LCD_GLYPH_LAST_USE  (lcd_Ptr->s_glyphLastUse)
+#define LCD_GLYPH_CLOCK     (lcd_Ptr->s_glyphClock)
+#else
+#define LCD_CTRL_OUT        LCD_CTRL_PORT
+#define LCD_CTRL_DIR        LCD_CTRL_PORT_DIR
+#define LCD_DATA_OUT        LCD_DATA_PORT
+#define LCD_DATA_DIR        LCD_DATA_PORT_DIR
+#define LCD_DATA_IN         LCD_DATA_PORT_IN
+#define LCD_RS_MASK         (1<<RS)
+#define LCD_RW_MASK         (1<<RW)
+#define LCD_E_MASK          (1<<E)
+#define LCD_IS_4_BITS       (DATA_BITS_MODE == 4)
+#ifdef UPPER_PORT_PINS
+#define LCD_IS_UPPER_PINS   TRUE
+#else
+#define LCD_IS_UPPER_PINS   FALSE
+#endif
+#define LCD_COLUMNS         LCD_COLS
+#define LCD_GLYPH_RESIDENT  g_glyphResident
+#define LCD_GLYPH_LAST_USE  g_glyphLastUse
+#define LCD_GLYPH_CLOCK     g_glyphClock
+#endif
+
+/* Data port pins connected to the LCD */
+#define LCD_DATA_MASK  (LCD_IS_4_BITS ? (LCD_IS_UPPER_PINS ? 0xF0 : 0x0F) : 0xFF)
+
+/* Busy flag (DB7) in the data port (in 4 bits mode it is read in the high nibble) */
+#define LCD_BUSY_MASK  ((LCD_IS_4_BITS && !LCD_IS_UPPER_PINS) ? 0x08 : 0x80)
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+#ifdef LCD_FRAMEBUFFER
+/* Characters written by the application */
+static uint8 g_lcdBuffer[LCD_ROWS][LCD_COLS];
+
+/* Characters currently shown on the LCD */
+static uint8 g_lcdScreen[LCD_ROWS][LCD_COLS];
+#endif
+
+/* Powers of ten used to get the decimal digits by subtraction (no division) */
+static const uint32 g_powersOfTen[9] =
+{
+	1000000000UL,100000000UL,10000000UL,1000000UL,100000UL,10000UL,1000UL,100UL,10UL
+};
+
+static const char g_hexDigits[16] = "0123456789ABCDEF";
+
+#ifndef LCD_MULTI_DISPLAY
+/* Glyph pattern resident in every CGRAM slot (NULL_PTR if the slot is free) */
+static const uint8 *g_glyphResident[LCD_GLYPHS];
+
+/* Last use of every CGRAM slot (the least recently used slot is replaced) */
+static uint16 g_glyphLastUse[LCD_GLYPHS];
+static uint16 g_glyphClock = 0;
+#endif
+
+/* Bar graph cells partially filled with 1 to 4 columns from the left */
+static const uint8 g_horizontalBarGlyphs[4][8] =
+{
+	{0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x10},
+	{0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18},
+	{0x1C,0x1C,0x1C,0x1C,0x1C,0x1C,0x1C,0x1C},
+	{0x1E,0x1E,0x1E,0x1E,0x1E,0x1E,0x1E,0x1E}
+};
+
+/* Bar graph cells partially filled with 1 to 7 rows from the bottom */
+static const uint8 g_verticalBarGlyphs[7][8] =
+{
+	{0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x1F},
+	{0x00,0x00,0x00,0x00,0x00,0x00,0x1F,0x1F},
+	{0x00,0x00,0x00,0x00,0x00,0x1F,0x1F,0x1F},
+	{0x00,0x00,0x00,0x00,0x1F,0x1F,0x1F,0x1F},
+	{0x00,0x00,0x00,0x1F,0x1F,0x1F,0x1F,0x1F},
+	{0x00,0x00,0x1F,0x1F,0x1F,0x1F,0x1F,0x1F},
+	{0x00,0x1F,0x1F,0x1F,0x1F,0x1F,0x1F,0x1F}
+};
+
+#ifdef LCD_ASYNC
+/* Pending operations from the application (producer) to LCD_asyncTick (consumer) ,
+ * bit 8 is RS (HIGH for data , LOW for command) and bits 7:0 are the byte */
+RING_BUFFER_DEFINE(lcdQueue,uint16,LCD_QUEUE_SIZE)
+static lcdQueue_RingType g_lcdQueue;
+
+#ifndef LCD_BUSY_FLAG
+/* Ticks to skip until the last sent operation is executed */
+static volatile uint8 g_lcdHoldTicks = 0;
+#endif
+#endif
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+#ifdef LCD_FRAMEBUFFER
+/* Fills a copy of the screen with spaces (what the LCD shows after clear command) */
+static void LCD_fillSpaces(uint8 screen[LCD_ROWS][LCD_COLS])
+{
+	uint8 row,col;
+
+	for(row=0;row<LCD_ROWS;row++)
+	{
+		for(col=0;col<LCD_COLS;col++)
+		{
+			screen[row][col] = ' ';
+		}
+	}
+}
+#endif
+
+/* Puts the 4 least significant bits of a value on the 4 data port pins connected to the LCD */
+static void LCD_putNibble(LCD_HANDLE_PARAM uint8 nibble)
+{
+	if(LCD_IS_UPPER_PINS){
+		LCD_DATA_OUT=(LCD_DATA_OUT& 0x0F)|((nibble& 0x0F)<<4);
+	}
+	else{
+		LCD_DATA_OUT=(LCD_DATA_OUT& 0xF0)|(nibble& 0x0F);
+	}
+}
+
+/* Data on the data port is latched by the LCD on the falling edge of E */
+static void LCD_strobe(LCD_HANDLE_ONLY)
+{
+	LCD_CTRL_OUT |= LCD_E_MASK;	 /* Enable LCD display */
+	_delay_us(LCD_T_PW_US);
+	LCD_CTRL_OUT &= ~LCD_E_MASK;  /* disable LCD display */
+	_delay_us(LCD_T_H_US);
+}
+
+#ifdef LCD_BUSY_FLAG
+/* Reads the busy flag through RW=1 once, returns TRUE while the LCD executes its last operation */
+static uint8 LCD_readBusy(LCD_HANDLE_ONLY)
+{
+	uint8 busy;
+
+	LCD_DATA_DIR &= (uint8)~LCD_DATA_MASK;	/* data pins as input pins to read the LCD */
+
+	LCD_CTRL_OUT &= ~LCD_RS_MASK;	/* selecting command register (busy flag + address) */
+	LCD_CTRL_OUT |= LCD_RW_MASK;	/* to read from LCD (RW=1) */
+	_delay_us(LCD_T_AS_US);
+
+	LCD_CTRL_OUT |= LCD_E_MASK;
+	_delay_us(LCD_T_PW_US);	/* data delay time before the flag is valid */
+	busy = (LCD_DATA_IN & LCD_BUSY_MASK) ? TRUE : FALSE;
+	LCD_CTRL_OUT &= ~LCD_E_MASK;
+	_delay_us(LCD_T_H_US);
+	if(LCD_IS_4_BITS){
+		LCD_strobe(LCD_HANDLE_ARG_ONLY);	/* second nibble (low address bits) is not needed */
+	}
+
+	LCD_CTRL_OUT &= ~LCD_RW_MASK;	/* back to write data to LCD (RW=0) */
+
+	LCD_DATA_DIR |= LCD_DATA_MASK;
+
+	return busy;
+}
+
+/* Reads the busy flag until the LCD finished its last operation */
+static void LCD_waitBusy(LCD_HANDLE_ONLY)
+{
+	uint16 timeout = LCD_BUSY_TIMEOUT;
+
+	while(LCD_readBusy(LCD_HANDLE_ARG_ONLY) && (--timeout != 0)){}
+}
+#endif
+
+/* Sends one byte to the command register (rs=LOW) or data register (rs=HIGH) */
+static void LCD_write(LCD_HANDLE_PARAM uint8 rs,uint8 value)
+{
+	if(rs){
+		LCD_CTRL_OUT |= LCD_RS_MASK;	/* selecting data register */
+	}
+	else{
+		LCD_CTRL_OUT &= ~LCD_RS_MASK;	/* selecting command register */
+	}
+	LCD_CTRL_OUT &= ~LCD_RW_MASK;	/* to write data to LCD (RW=0) */
+	_delay_us(LCD_T_AS_US);
+
+	if(LCD_IS_4_BITS){            /* In case 4 bits mode the byte will be sent on two steps */
+		LCD_putNibble(LCD_HANDLE_ARG value>>4);	/* the 4 most significant bits firstly (from data sheet) */
+		LCD_strobe(LCD_HANDLE_ARG_ONLY);
+		LCD_putNibble(LCD_HANDLE_ARG value);	/* the 4 least significant bits secondly (from data sheet) */
+		LCD_strobe(LCD_HANDLE_ARG_ONLY);
+	}
+	else{    /* In case 8 bits mode the byte will be sent on one step */
+		LCD_DATA_OUT=value;
+		LCD_strobe(LCD_HANDLE_ARG_ONLY);
+	}
+}
+
+/* Writes the decimal digits of a value (at least minDigits digits with leading zeros)
+ * every digit is counted by subtracting its power of ten, returns the number of digits */
+static uint8 LCD_decimalDigits(char *buff,uint32 value,uint8 minDigits)
+{
+	uint8 i;
+	uint8 len = 0;
+	char digit;
+
+	if((value <= 0xFFFF) && (minDigits <= 5))
+	{
+		/* 16-bit values need 5 digits at most and 16-bit subtraction only */
+		uint16 value16 = (uint16)value;
+
+		for(i=5;i<9;i++)
+		{
+			uint16 power = (uint16)g_powersOfTen[i];
+
+			digit = '0';
+			while(value16 >= power)
+			{
+				value16 -= power;
+				digit++;
+			}
+			if((len != 0) || (digit != '0') || ((10 - i) <= minDigits))
+			{
+				buff[len++] = digit;
+			}
+		}
+		buff[len++] = '0' + (uint8)value16;
+		return len;
+	}
+
+	for(i=0;i<9;i++)
+	{
+		digit = '0';
+		while(value >= g_powersOfTen[i])
+		{
+			value -= g_powersOfTen[i];
+			digit++;
+		}
+		if((len != 0) || (digit != '0') || ((10 - i) <= minDigits))
+		{
+			buff[len++] = digit;
+		}
+	}
+	buff[len++] = '0' + (uint8)value;
+	return len;
+}
+
+/* Writes sign and digits right aligned in a field of width characters, zero padding is put
+ * after the sign and space padding before it , returns the string length */
+static uint8 LCD_formatField(char *buff,const char *digits,uint8 len,uint8 negative,uint8 width,char pad)
+{
+	uint8 i = 0;
+	uint8 padCount = 0;
+
+	if(width > (len + negative))
+	{
+		padCount = width - len - negative;
+	}
+
+	if(pad != '0')
+	{
+		while(padCount != 0)
+		{
+			buff[i++] = pad;
+			padCount--;
+		}
+	}
+	if(negative)
+	{
+		buff[i++] = '-';
+	}
+	while(padCount != 0)
+	{
+		buff[i++] = '0';
+		padCount--;
+	}
+	while(len != 0)
+	{
+		buff[i++] = *digits++;
+		len--;
+	}
+	buff[i] = '\0';
+	return i;
+}
+
+#ifdef LCD_ASYNC
+/* Adds one operation to the queue, waits if the queue is full until the tick sends an operation ,
+ * with the interrupts disabled (in an ISR or an atomic section) the timer can't run the tick so
+ * it is called from here once every tick period */
+static void LCD_enqueue(uint8 rs,uint8 value)
+{
+	uint16 entry = ((uint16)rs<<8) | value;
+
+	while(lcdQueue_push(&g_lcdQueue,&entry) == ERROR)
+	{
+		if(BIT_IS_CLEAR(SREG,SREG_I))
+		{
+#ifndef LCD_BUSY_FLAG
+			_delay_us(LCD_ASYNC_TICK_US);
+#endif
+			LCD_asyncTick();
+		}
+	}
+}
+#endif
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
 
  /******************************************************************************
  *
@@ -24,25 +373,37 @@
  *
  *******************************************************************************/
 
-void LCD_init(void)
+void LCD_init(LCD_HANDLE_ONLY)
 {
-	LCD_CTRL_PORT_DIR |= (1<<E) | (1<<RS) | (1<<RW);     /* Configure the control pins(E,RS,RW) as output pins */
+	uint8 i;
+
+	LCD_CTRL_OUT &= ~LCD_E_MASK;	/* E low so the LCD ignores the bus (it may be shared with other LCDs) */
+	LCD_CTRL_DIR |= LCD_E_MASK | LCD_RS_MASK | LCD_RW_MASK;     /* Configure the control pins(E,RS,RW) as output pins */
+
+	_delay_ms(20);	/* wait for the LCD power on reset (15ms from data sheet) */
+
+	/* Configure the data port pins connected to the LCD (all pins or the highest/lowest 4 pins) as output pins */
+	LCD_DATA_DIR |= LCD_DATA_MASK;
 
-	#if (DATA_BITS_MODE == 4)
-		#ifdef UPPER_PORT_PINS
-			LCD_DATA_PORT_DIR |= 0xF0; 	/* Configure the highest 4 bits of the data port as output pins */
-		#else
-			LCD_DATA_PORT_DIR |= 0x0F;	 /* Configure the lowest 4 bits of the data port as output pins */
-		#endif
-		LCD_sendCommand(FOUR_BITS_DATA_MODE);	/* initialize LCD as 4-bit mode */
-		LCD_sendCommand(TWO_LINE_LCD_Four_BIT_MODE);     /* use 2-line lcd + 4-bit Data Mode + 5*7 dot display Mode */
-	#elif (DATA_BITS_MODE == 8)
-		LCD_DATA_PORT_DIR = 0xFF;   /* Configure the data port as output port */
-		LCD_sendCommand(TWO_LINE_LCD_Eight_BIT_MODE);   /* use 2-line lcd + 8-bit Data Mode + 5*7 dot display Mode */
-	#endif
+	if(LCD_IS_4_BITS){
+		LCD_sendCommand(LCD_HANDLE_ARG FOUR_BITS_DATA_MODE);	/* initialize LCD as 4-bit mode */
+		LCD_sendCommand(LCD_HANDLE_ARG TWO_LINE_LCD_Four_BIT_MODE);     /* use 2-line lcd + 4-bit Data Mode + 5*7 dot display Mode */
+	}
+	else{
+		LCD_sendCommand(LCD_HANDLE_ARG TWO_LINE_LCD_Eight_BIT_MODE);   /* use 2-line lcd + 8-bit Data Mode + 5*7 dot display Mode */
+	}
 
-	LCD_sendCommand(CURSOR_OFF);    /* cursor off */
-	LCD_sendCommand(CLEAR_COMMAND);     /* clear LCD at the beginning */
+	LCD_sendCommand(LCD_HANDLE_ARG CURSOR_OFF);    /* cursor off */
+	LCD_clearScreen(LCD_HANDLE_ARG_ONLY);     /* clear LCD at the beginning */
+
+	for(i=0;i<LCD_GLYPHS;i++)
+	{
+		LCD_GLYPH_RESIDENT[i] = NULL_PTR;	/* CGRAM content is unknown after reset */
+	}
+
+#ifdef LCD_FRAMEBUFFER
+	LCD_fillSpaces(g_lcdBuffer);
+#endif
 }
 
 /******************************************************************************
@@ -59,46 +420,24 @@ void LCD_init(void)
 *
 *******************************************************************************/
 
-void LCD_sendCommand(uint8 command)
+void LCD_sendCommand(LCD_HANDLE_PARAM uint8 command)
 {
-	CLEAR_BIT(LCD_CTRL_PORT,RS);	/* selecting command register */
-	CLEAR_BIT(LCD_CTRL_PORT,RW);	/* to write data to LCD (RW=0) */
-	_delay_ms(1);	/* minimum delay for processing Tas = 50ns (from data sheet) */
-	SET_BIT(LCD_CTRL_PORT,E);	 /* Enable LCD display */
-	_delay_ms(1);	/* minimum delay for processing Tpw - Tdws = 190ns (from data sheet) */
-
-#if(DATA_BITS_MODE==4)            /* In case 4 bits mode the command will be sent on two steps */
-#ifdef UPPER_PORT_PINS
-    /* putting the 4 most significant bits firstly (from data sheet) of the command on the upper port pins*/
-	LCD_DATA_PORT=(LCD_DATA_PORT& 0x0F)|(command& 0xF0);
+#if defined(LCD_ASYNC)
+	LCD_enqueue(LOW,command);	/* sent later by LCD_asyncTick */
+#elif defined(LCD_BUSY_FLAG)
+	LCD_waitBusy(LCD_HANDLE_ARG_ONLY);	/* wait until the previous operation is executed */
+	LCD_write(LCD_HANDLE_ARG LOW,command);
 #else
-	/*putting the 4 most significant bits firstly (from data sheet) of the command on the lower port pins*/
-	LCD_DATA_PORT=(LCD_DATA_PORT& 0xF0)|((command& 0xF0)>>4);
-#endif
-	_delay_ms(1);      /* minimum delay for processing Tdsw = 100ns (from data sheet) */
-	CLEAR_BIT(LCD_CTRL_PORT,E);   /* disable LCD display */
-	_delay_ms(1);    /* minimum delay for processing Th = 13ns (from data sheet) */
-	SET_BIT(LCD_CTRL_PORT,E);  /* Enable LCD display */
-	_delay_ms(1);  /* minimum delay for processing Tpw - Tdws = 190ns (from data sheet) */
+	LCD_write(LCD_HANDLE_ARG LOW,command);
 
-#ifdef UPPER_PORT_PINS
-	 /* putting the 4 least significant bits secondly (from data sheet) of the command on the upper port pins*/
-	LCD_DATA_PORT=(LCD_DATA_PORT& 0x0F)|((command& 0x0F)<<4);
-#else
-	/* putting the 4 least significant bits secondly (from data sheet) of the command on the lower port pins*/
-	LCD_DATA_PORT=(LCD_DATA_PORT& 0xF0)|((command& 0x0F));
-#endif
-	_delay_ms(1);   /* minimum delay for processing Tdsw = 100ns (from data sheet) */
-	CLEAR_BIT(LCD_CTRL_PORT,E);  /* disable LCD display */
-	_delay_ms(1);   /* minimum delay for processing Th = 13ns (from data sheet) */
-
-#elif(DATA_BITS_MODE==8)    /* In case 8 bits mode the command will be sent on one step */
-	LCD_DATA_PORT=command;    /* Sending command on LCD data port */
-	_delay_ms(1);             /* minimum delay for processing Tdsw = 100ns (from data sheet) */
-	CLEAR_BIT(LCD_CTRL_PORT,E);  /* disable LCD display */
-	_delay_ms(1);           /* minimum delay for processing Th = 13ns (from data sheet) */
+	/* wait the command execution time , clear display and return home (0x01 to 0x03) are the slow ones */
+	if(command <= 0x03){
+		_delay_us(LCD_LONG_EXEC_US);
+	}
+	else{
+		_delay_us(LCD_EXEC_US);
+	}
 #endif
-
 }
 
 
@@ -115,46 +454,17 @@ void LCD_sendCommand(uint8 command)
 *
 *******************************************************************************/
 
-void LCD_displayCharacter(uint8 data)
+void LCD_displayCharacter(LCD_HANDLE_PARAM uint8 data)
 {
-	SET_BIT(LCD_CTRL_PORT,RS);	/* selecting data register */
-	CLEAR_BIT(LCD_CTRL_PORT,RW);	/* to write data to LCD (RW=0) */
-	_delay_ms(1);	/* minimum delay for processing Tas = 50ns (from data sheet) */
-	SET_BIT(LCD_CTRL_PORT,E);	 /* Enable LCD display */
-	_delay_ms(1);	/* minimum delay for processing Tpw - Tdws = 190ns (from data sheet) */
-
-#if(DATA_BITS_MODE==4)            /* In case 4 bits mode the character will be sent on two steps */
-#ifdef UPPER_PORT_PINS
-    /* putting the 4 most significant bits firstly (from data sheet) of the character on the upper port pins*/
-	LCD_DATA_PORT=(LCD_DATA_PORT& 0x0F)|(data& 0xF0);
+#if defined(LCD_ASYNC)
+	LCD_enqueue(HIGH,data);	/* sent later by LCD_asyncTick */
+#elif defined(LCD_BUSY_FLAG)
+	LCD_waitBusy(LCD_HANDLE_ARG_ONLY);	/* wait until the previous operation is executed */
+	LCD_write(LCD_HANDLE_ARG HIGH,data);
 #else
-	/*putting the 4 most significant bits firstly (from data sheet) of the character on the lower port pins*/
-	LCD_DATA_PORT=(LCD_DATA_PORT& 0xF0)|((data& 0xF0)>>4);
+	LCD_write(LCD_HANDLE_ARG HIGH,data);
+	_delay_us(LCD_EXEC_US);	/* wait the data write execution time */
 #endif
-	_delay_ms(1);      /* minimum delay for processing Tdsw = 100ns (from data sheet) */
-	CLEAR_BIT(LCD_CTRL_PORT,E);   /* disable LCD display */
-	_delay_ms(1);    /* minimum delay for processing Th = 13ns (from data sheet) */
-	SET_BIT(LCD_CTRL_PORT,E);  /* Enable LCD display */
-	_delay_ms(1);  /* minimum delay for processing Tpw - Tdws = 190ns (from data sheet) */
-
-#ifdef UPPER_PORT_PINS
-	 /* putting the 4 least significant bits secondly (from data sheet) of the character on the upper port pins*/
-	LCD_DATA_PORT=(LCD_DATA_PORT& 0x0F)|((data& 0x0F)<<4);
-#else
-	/* putting the 4 least significant bits secondly (from data sheet) of the character on the lower port pins*/
-	LCD_DATA_PORT=(LCD_DATA_PORT& 0xF0)|((data& 0x0F));
-#endif
-	_delay_ms(1);   /* minimum delay for processing Tdsw = 100ns (from data sheet) */
-	CLEAR_BIT(LCD_CTRL_PORT,E);  /* disable LCD display */
-	_delay_ms(1);   /* minimum delay for processing Th = 13ns (from data sheet) */
-
-#elif(DATA_BITS_MODE==8)    /* In case 8 bits mode the character will be sent on one step */
-	LCD_DATA_PORT=data;    /* Sending character on LCD data port */
-	_delay_ms(1);             /* minimum delay for processing Tdsw = 100ns (from data sheet) */
-	CLEAR_BIT(LCD_CTRL_PORT,E);  /* disable LCD display */
-	_delay_ms(1);           /* minimum delay for processing Th = 13ns (from data sheet) */
-#endif
-
 }
 
 /******************************************************************************
@@ -170,13 +480,13 @@ void LCD_displayCharacter(uint8 data)
 *
 *******************************************************************************/
 
-void LCD_displayString(const char *str)
+void LCD_displayString(LCD_HANDLE_PARAM const char *str)
 {
 	/* displaying each character of the string by looping */
 	uint8 i;
 	for(i=0;str[i]!='\0';i++)
 	{
-		LCD_displayCharacter(str[i]);
+		LCD_displayCharacter(LCD_HANDLE_ARG str[i]);
 	}
 }
 
@@ -195,7 +505,7 @@ void LCD_displayString(const char *str)
 *
 *******************************************************************************/
 
-void LCD_goToRowColumn(uint8 row,uint8 col){
+void LCD_goToRowColumn(LCD_HANDLE_PARAM uint8 row,uint8 col){
 
 	uint8 Address;
 	/*  first calculating the address of the required position (from data sheet) */
@@ -208,16 +518,18 @@ void LCD_goToRowColumn(uint8 row,uint8 col){
 				Address=col+0x40;
 				break;
 		case 2:
-				Address=col+0x10;
+				Address=col+LCD_COLUMNS;
 				break;
 		case 3:
-				Address=col+0x50;
+				Address=col+0x40+LCD_COLUMNS;
 				break;
+		default:
+				return;
 	}
 
 	/* to write to a specific address in the LCD
 	 * we need to apply the corresponding command 0b10000000+Address */
-	LCD_sendCommand(Address | SET_CURSOR_LOCATION);
+	LCD_sendCommand(LCD_HANDLE_ARG Address | SET_CURSOR_LOCATION);
 }
 
 
@@ -236,10 +548,10 @@ void LCD_goToRowColumn(uint8 row,uint8 col){
 * [returns]: NONE
 *
 *******************************************************************************/
-void LCD_displayStringRowColumn(uint8 row,uint8 col,const char *Str)
+void LCD_displayStringRowColumn(LCD_HANDLE_PARAM uint8 row,uint8 col,const char *Str)
 {
-	LCD_goToRowColumn(row,col); /* go to to the required LCD position */
-	LCD_displayString(Str); /* display the string */
+	LCD_goToRowColumn(LCD_HANDLE_ARG row,col); /* go to to the required LCD position */
+	LCD_displayString(LCD_HANDLE_ARG Str); /* display the string */
 }
 
 
@@ -256,11 +568,9 @@ void LCD_displayStringRowColumn(uint8 row,uint8 col,const char *Str)
 *
 *******************************************************************************/
 
-void LCD_integerToString(int data)
+void LCD_integerToString(LCD_HANDLE_PARAM int data)
 {
-   char buff[16]; /* String to hold the ascii result */
-   itoa(data,buff,10); /* 10 for decimal */
-   LCD_displayString(buff);
+   LCD_displaySigned(LCD_HANDLE_ARG data,0,' ');
 }
 
 
@@ -275,9 +585,666 @@ void LCD_integerToString(int data)
 * [returns]: NONE
 *
 *******************************************************************************/
-void LCD_clearScreen(void)
+void LCD_clearScreen(LCD_HANDLE_ONLY)
 {
-	LCD_sendCommand(CLEAR_COMMAND); /*clear display screen*/
+	LCD_sendCommand(LCD_HANDLE_ARG CLEAR_COMMAND); /*clear display screen*/
+
+#ifdef LCD_FRAMEBUFFER
+	LCD_fillSpaces(g_lcdScreen);	/* the next LCD_refresh redraws the frame buffer */
+#endif
+}
+
+#ifdef LCD_FRAMEBUFFER
+/******************************************************************************
+*
+* [Function name]: LCD_bufferClear
+*
+* [Description]: the function clears the frame buffer (the LCD is changed by LCD_refresh)
+*
+* [Args]: NONE
+*
+* [returns]: NONE
+*
+*******************************************************************************/
+void LCD_bufferClear(void)
+{
+	LCD_fillSpaces(g_lcdBuffer);
+}
+
+
+/******************************************************************************
+*
+* [Function name]: LCD_bufferWriteCharacter
+*
+* [Description]: the function writes one character in the frame buffer
+*                (the LCD is changed by LCD_refresh)
+*
+* [Args]: uint8 row, uint8 col, uint8 data:
+*               The position of the character and the character
+*
+* [returns]: NONE
+*
+*******************************************************************************/
+void LCD_bufferWriteCharacter(uint8 row,uint8 col,uint8 data)
+{
+	if((row < LCD_ROWS) && (col < LCD_COLS))
+	{
+		g_lcdBuffer[row][col] = data;
+	}
 }
 
 
+/******************************************************************************
+*
+* [Function name]: LCD_bufferWriteString
+*
+* [Description]: the function writes a string in the frame buffer starting from a
+*                certain position, characters after the end of the row are dropped
+*                (the LCD is changed by LCD_refresh)
+*
+* [Args]: uint8 row, uint8 col , char *Str :
+*               The start position and the string
+*
+* [returns]: NONE
+*
+*******************************************************************************/
+void LCD_bufferWriteString(uint8 row,uint8 col,const char *Str)
+{
+	if(row >= LCD_ROWS)
+		return;
+
+	while((*Str != '\0') && (col < LCD_COLS))
+	{
+		g_lcdBuffer[row][col] = *Str;
+		Str++;
+		col++;
+	}
+}
+
+
+/******************************************************************************
+*
+* [Function name]: LCD_refresh
+*
+* [Description]: the function sends to the LCD only the characters of the frame buffer
+*                which differ from the characters on the screen, the cursor is moved
+*                only when the next changed character doesn't follow the last sent one
+*
+* [Args]: NONE
+*
+* [returns]: NONE
+*
+* [Remarks]: writing to the LCD with the other functions (except LCD_clearScreen)
+*            makes the screen copy wrong, use either the frame buffer or them
+*
+*******************************************************************************/
+void LCD_refresh(void)
+{
+	uint8 row,col;
+	uint8 cursorRow = 0xFF;	/* cursor position is unknown at the beginning */
+	uint8 cursorCol = 0xFF;
+
+	for(row=0;row<LCD_ROWS;row++)
+	{
+		for(col=0;col<LCD_COLS;col++)
+		{
+			if(g_lcdBuffer[row][col] == g_lcdScreen[row][col])
+			{
+				continue;
+			}
+
+			if((row != cursorRow) || (col != cursorCol))
+			{
+				LCD_goToRowColumn(LCD_HANDLE_ARG row,col);
+				cursorRow = row;
+			}
+
+			LCD_displayCharacter(LCD_HANDLE_ARG g_lcdBuffer[row][col]);
+			g_lcdScreen[row][col] = g_lcdBuffer[row][col];
+			cursorCol = col + 1;	/* the LCD increments the address after every character */
+		}
+	}
+}
+#endif
+
+#ifdef LCD_ASYNC
+/******************************************************************************
+*
+* [Function name]: LCD_asyncInit
+*
+* [Description]: the function starts the timer that sends the queued LCD operations
+*                (one operation every timer interrupt)
+*
+* [Args]: Pointer to Struct timer_ConfigType
+*               timer configuration, its interrupt period must be LCD_ASYNC_TICK_US
+*
+* [returns]: NONE
+*
+* [Remarks]: In case of compile time binding of timer call backs call LCD_asyncTick
+*            from the hook of the timer interrupt
+*
+*******************************************************************************/
+void LCD_asyncInit(const timer_ConfigType * config_Ptr)
+{
+#ifndef TIMER_STATIC_CALLBACK
+	if(config_Ptr->s_timerType==0){
+		timer0_setCallBack(LCD_asyncTick);
+	}
+	else if(config_Ptr->s_timerType==1){
+		timer1_setCallBack(LCD_asyncTick);
+	}
+	else if(config_Ptr->s_timerType==2){
+		timer2_setCallBack(LCD_asyncTick);
+	}
+#endif
+
+	timer_init(config_Ptr);
+}
+
+
+/******************************************************************************
+*
+* [Function name]: LCD_asyncTick
+*
+* [Description]: the function sends the oldest queued operation to the LCD if the LCD
+*                finished the previous one (busy flag or execution time in ticks)
+*
+* [Args]: NONE
+*
+* [returns]: NONE
+*
+*******************************************************************************/
+void LCD_asyncTick(void)
+{
+	uint16 entry;
+
+#ifdef LCD_BUSY_FLAG
+	if(LCD_readBusy(LCD_HANDLE_ARG_ONLY))
+		return;
+#else
+	if(g_lcdHoldTicks != 0)
+	{
+		g_lcdHoldTicks--;
+		return;
+	}
+#endif
+
+	if(lcdQueue_pop(&g_lcdQueue,&entry) == ERROR)
+		return;		/* nothing to send */
+
+	LCD_write(LCD_HANDLE_ARG (uint8)(entry>>8),(uint8)entry);
+
+#ifndef LCD_BUSY_FLAG
+	/* clear display and return home (0x01 to 0x03) are the slow commands */
+	if(((entry>>8) == LOW) && ((uint8)entry <= 0x03)){
+		g_lcdHoldTicks = LCD_LONG_EXEC_TICKS;
+	}
+	else{
+		g_lcdHoldTicks = LCD_EXEC_TICKS;
+	}
+#endif
+}
+
+
+/******************************************************************************
+*
+* [Function name]: LCD_isIdle
+*
+* [Description]: the function checks if all queued operations were sent
+*
+* [Args]: NONE
+*
+* [returns]: TRUE if the queue is empty , FALSE otherwise
+*
+*******************************************************************************/
+uint8 LCD_isIdle(void)
+{
+	return (lcdQueue_count(&g_lcdQueue) == 0) ? TRUE : FALSE;
+}
+#endif
+
+
+/******************************************************************************
+*
+* [Function name]: LCD_formatUnsigned
+*
+* [Description]: the function writes an unsigned number in decimal to a string
+*
+* [Args]: char *buff:
+*               the string (at least max(width,10)+1 characters)
+*         uint32 value:
+*               the number
+*         uint8 width, char pad:
+*               minimum number of characters , the number is right aligned and
+*               the left characters are filled with pad (' ' or '0')
+*
+* [returns]: length of the string
+*
+*******************************************************************************/
+uint8 LCD_formatUnsigned(char *buff,uint32 value,uint8 width,char pad)
+{
+	char digits[10];
+	uint8 len = LCD_decimalDigits(digits,value,1);
+
+	return LCD_formatField(buff,digits,len,FALSE,width,pad);
+}
+
+
+/******************************************************************************
+*
+* [Function name]: LCD_formatSigned
+*
+* [Description]: the function writes a signed number in decimal to a string
+*
+* [Args]: char *buff:
+*               the string (at least max(width,11)+1 characters)
+*         sint32 value:
+*               the number
+*         uint8 width, char pad:
+*               minimum number of characters , the number is right aligned and
+*               the left characters are filled with pad (' ' or '0')
+*
+* [returns]: length of the string
+*
+*******************************************************************************/
+uint8 LCD_formatSigned(char *buff,sint32 value,uint8 width,char pad)
+{
+	char digits[10];
+	uint8 negative = (value < 0) ? TRUE : FALSE;
+	uint32 magnitude = negative ? (0UL - (uint32)value) : (uint32)value;
+	uint8 len = LCD_decimalDigits(digits,magnitude,1);
+
+	return LCD_formatField(buff,digits,len,negative,width,pad);
+}
+
+
+/******************************************************************************
+*
+* [Function name]: LCD_formatHex
+*
+* [Description]: the function writes a number in hexadecimal (capital letters) to a string
+*
+* [Args]: char *buff:
+*               the string (at least max(width,8)+1 characters)
+*         uint32 value:
+*               the number
+*         uint8 width, char pad:
+*               minimum number of characters , the number is right aligned and
+*               the left characters are filled with pad (' ' or '0')
+*
+* [returns]: length of the string
+*
+*******************************************************************************/
+uint8 LCD_formatHex(char *buff,uint32 value,uint8 width,char pad)
+{
+	char digits[8];
+	uint8 len = 0;
+	sint8 shift;
+
+	for(shift=28;shift>=0;shift-=4)
+	{
+		uint8 nibble = (uint8)(value>>shift) & 0x0F;
+
+		if((len != 0) || (nibble != 0) || (shift == 0))
+		{
+			digits[len++] = g_hexDigits[nibble];
+		}
+	}
+
+	return LCD_formatField(buff,digits,len,FALSE,width,pad);
+}
+
+
+/******************************************************************************
+*
+* [Function name]: LCD_formatFixedPoint
+*
+* [Description]: the function writes a fixed point number (an integer scaled by 10^decimals,
+*                for example 12345 millivolts with 3 decimals is 12.345) to a string
+*
+* [Args]: char *buff:
+*               the string (at least max(width,12)+1 characters)
+*         sint32 value:
+*               the number multiplied by 10^decimals
+*         uint8 decimals:
+*               number of digits after the decimal point (0 to 9)
+*         uint8 width, char pad:
+*               minimum number of characters , the number is right aligned and
+*               the left characters are filled with pad (' ' or '0')
+*
+* [returns]: length of the string
+*
+*******************************************************************************/
+uint8 LCD_formatFixedPoint(char *buff,sint32 value,uint8 decimals,uint8 width,char pad)
+{
+	char digits[11];
+	uint8 negative = (value < 0) ? TRUE : FALSE;
+	uint32 magnitude = negative ? (0UL - (uint32)value) : (uint32)value;
+	uint8 len;
+	uint8 i;
+
+	if(decimals > 9)
+	{
+		decimals = 9;
+	}
+
+	/* one integer digit at least before the point */
+	len = LCD_decimalDigits(digits,magnitude,decimals + 1);
+
+	if(decimals != 0)
+	{
+		/* shift the decimals right to insert the point before them */
+		for(i=len;i>(len - decimals);i--)
+		{
+			digits[i] = digits[i-1];
+		}
+		digits[len - decimals] = '.';
+		len++;
+	}
+
+	return LCD_formatField(buff,digits,len,negative,width,pad);
+}
+
+
+/******************************************************************************
+*
+* [Function name]: LCD_displayUnsigned
+*
+* [Description]: the function displays an unsigned number in decimal on the LCD
+*
+* [Args]: uint32 value:
+*               the number
+*         uint8 width, char pad:
+*               minimum number of characters (up to 16) , the number is right aligned
+*               and the left characters are filled with pad (' ' or '0')
+*
+* [returns]: NONE
+*
+*******************************************************************************/
+void LCD_displayUnsigned(LCD_HANDLE_PARAM uint32 value,uint8 width,char pad)
+{
+	char buff[LCD_FORMAT_BUFFER_SIZE];
+
+	LCD_formatUnsigned(buff,value,(width > LCD_FORMAT_MAX_WIDTH) ? LCD_FORMAT_MAX_WIDTH : width,pad);
+	LCD_displayString(LCD_HANDLE_ARG buff);
+}
+
+
+/******************************************************************************
+*
+* [Function name]: LCD_displaySigned
+*
+* [Description]: the function displays a signed number in decimal on the LCD
+*
+* [Args]: sint32 value:
+*               the number
+*         uint8 width, char pad:
+*               minimum number of characters (up to 16) , the number is right aligned
+*               and the left characters are filled with pad (' ' or '0')
+*
+* [returns]: NONE
+*
+*******************************************************************************/
+void LCD_displaySigned(LCD_HANDLE_PARAM sint32 value,uint8 width,char pad)
+{
+	char buff[LCD_FORMAT_BUFFER_SIZE];
+
+	LCD_formatSigned(buff,value,(width > LCD_FORMAT_MAX_WIDTH) ? LCD_FORMAT_MAX_WIDTH : width,pad);
+	LCD_displayString(LCD_HANDLE_ARG buff);
+}
+
+
+/******************************************************************************
+*
+* [Function name]: LCD_displayHex
+*
+* [Description]: the function displays a number in hexadecimal on the LCD
+*
+* [Args]: uint32 value:
+*               the number
+*         uint8 width, char pad:
+*               minimum number of characters (up to 16) , the number is right aligned
+*               and the left characters are filled with pad (' ' or '0')
+*
+* [returns]: NONE
+*
+*******************************************************************************/
+void LCD_displayHex(LCD_HANDLE_PARAM uint32 value,uint8 width,char pad)
+{
+	char buff[LCD_FORMAT_BUFFER_SIZE];
+
+	LCD_formatHex(buff,value,(width > LCD_FORMAT_MAX_WIDTH) ? LCD_FORMAT_MAX_WIDTH : width,pad);
+	LCD_displayString(LCD_HANDLE_ARG buff);
+}
+
+
+/******************************************************************************
+*
+* [Function name]: LCD_displayFixedPoint
+*
+* [Description]: the function displays a fixed point number (an integer scaled by
+*                10^decimals) on the LCD
+*
+* [Args]: sint32 value:
+*               the number multiplied by 10^decimals
+*         uint8 decimals:
+*               number of digits after the decimal point (0 to 9)
+*         uint8 width, char pad:
+*               minimum number of characters (up to 16) , the number is right aligned
+*               and the left characters are filled with pad (' ' or '0')
+*
+* [returns]: NONE
+*
+*******************************************************************************/
+void LCD_displayFixedPoint(LCD_HANDLE_PARAM sint32 value,uint8 decimals,uint8 width,char pad)
+{
+	char buff[LCD_FORMAT_BUFFER_SIZE];
+
+	LCD_formatFixedPoint(buff,value,decimals,(width > LCD_FORMAT_MAX_WIDTH) ? LCD_FORMAT_MAX_WIDTH : width,pad);
+	LCD_displayString(LCD_HANDLE_ARG buff);
+}
+
+
+/******************************************************************************
+*
+* [Function name]: LCD_uploadGlyph
+*
+* [Description]: the function writes a custom 5x8 character to a CGRAM slot
+*
+* [Args]: uint8 slot:
+*               CGRAM slot (0 to 7)
+*         const uint8 *pattern:
+*               8 rows from top to bottom , the lowest 5 bits of every row are the dots
+*
+* [returns]: NONE
+*
+* [Remarks]: the LCD address is left in the CGRAM so move the cursor
+*            (LCD_goToRowColumn) before displaying characters
+*
+*******************************************************************************/
+void LCD_uploadGlyph(LCD_HANDLE_PARAM uint8 slot,const uint8 *pattern)
+{
+	uint8 i;
+
+	slot &= (LCD_GLYPHS - 1);
+	LCD_sendCommand(LCD_HANDLE_ARG SET_CGRAM_ADDRESS | (slot<<3));
+	for(i=0;i<8;i++)
+	{
+		LCD_displayCharacter(LCD_HANDLE_ARG pattern[i]);
+	}
+	LCD_GLYPH_RESIDENT[slot] = pattern;
+}
+
+
+/******************************************************************************
+*
+* [Function name]: LCD_loadGlyph
+*
+* [Description]: the function returns the character code of a custom character, it is
+*                written to the CGRAM only if it is not already there (replacing the
+*                least recently used custom character)
+*
+* [Args]: const uint8 *pattern:
+*               8 rows of the character , the same pattern must always be given by
+*               the same address (the address identifies the character)
+*
+* [returns]: character code (8 to 15 , so it can be used inside strings)
+*
+* [Remarks]: if the CGRAM is written the cursor must be moved before displaying,
+*            so load the glyphs first then LCD_goToRowColumn
+*            at most 8 different custom characters can be on the screen together
+*
+*******************************************************************************/
+uint8 LCD_loadGlyph(LCD_HANDLE_PARAM const uint8 *pattern)
+{
+	uint8 slot;
+	uint8 oldest = 0;
+	uint8 freeSlot = LCD_GLYPHS;
+
+	LCD_GLYPH_CLOCK++;
+
+	/* every slot is checked for the pattern before a free or old slot is taken */
+	for(slot=0;slot<LCD_GLYPHS;slot++)
+	{
+		if(LCD_GLYPH_RESIDENT[slot] == pattern)
+		{
+			LCD_GLYPH_LAST_USE[slot] = LCD_GLYPH_CLOCK;
+			return slot | LCD_GLYPHS;	/* codes 8 to 15 show CGRAM slots 0 to 7 */
+		}
+
+		if(LCD_GLYPH_RESIDENT[slot] == NULL_PTR)
+		{
+			if(freeSlot == LCD_GLYPHS)
+			{
+				freeSlot = slot;
+			}
+		}
+		else if((uint16)(LCD_GLYPH_CLOCK - LCD_GLYPH_LAST_USE[slot]) > (uint16)(LCD_GLYPH_CLOCK - LCD_GLYPH_LAST_USE[oldest]))
+		{
+			oldest = slot;
+		}
+	}
+
+	/* free slot , no need to replace a glyph */
+	if(freeSlot != LCD_GLYPHS)
+	{
+		oldest = freeSlot;
+	}
+
+	LCD_uploadGlyph(LCD_HANDLE_ARG oldest,pattern);
+	LCD_GLYPH_LAST_USE[oldest] = LCD_GLYPH_CLOCK;
+	return oldest | LCD_GLYPHS;
+}
+
+
+/******************************************************************************
+*
+* [Function name]: LCD_displayHorizontalBar
+*
+* [Description]: the function displays a horizontal bar graph filled from the left
+*                with a resolution of one dot column (5 per character)
+*
+* [Args]: uint8 row, uint8 col:
+*               position of the left cell of the bar
+*         uint8 width:
+*               number of characters of the bar
+*         uint16 value, uint16 max:
+*               the bar is full when value >= max
+*
+* [returns]: NONE
+*
+*******************************************************************************/
+void LCD_displayHorizontalBar(LCD_HANDLE_PARAM uint8 row,uint8 col,uint8 width,uint16 value,uint16 max)
+{
+	uint16 columns;
+	uint8 partialCode = ' ';
+	uint8 i;
+
+	if(max == 0)
+		return;
+	if(value > max)
+		value = max;
+
+	columns = (uint16)(((uint32)value * width * 5) / max);	/* filled dot columns */
+
+	/* the glyph is loaded before moving the cursor (loading changes the LCD address) */
+	if((columns % 5) != 0)
+	{
+		partialCode = LCD_loadGlyph(LCD_HANDLE_ARG g_horizontalBarGlyphs[(columns % 5) - 1]);
+	}
+
+	LCD_goToRowColumn(LCD_HANDLE_ARG row,col);
+	for(i=0;i<width;i++)
+	{
+		if(columns >= 5)
+		{
+			LCD_displayCharacter(LCD_HANDLE_ARG LCD_FULL_BLOCK);
+			columns -= 5;
+		}
+		else if(columns != 0)
+		{
+			LCD_displayCharacter(LCD_HANDLE_ARG partialCode);
+			columns = 0;
+		}
+		else
+		{
+			LCD_displayCharacter(LCD_HANDLE_ARG ' ');
+		}
+	}
+}
+
+
+/******************************************************************************
+*
+* [Function name]: LCD_displayVerticalBar
+*
+* [Description]: the function displays a vertical bar graph filled from the bottom
+*                with a resolution of one dot row (8 per character)
+*
+* [Args]: uint8 row, uint8 col:
+*               position of the bottom cell of the bar
+*         uint8 height:
+*               number of characters of the bar (the bar grows to the upper rows)
+*         uint16 value, uint16 max:
+*               the bar is full when value >= max
+*
+* [returns]: NONE
+*
+*******************************************************************************/
+void LCD_displayVerticalBar(LCD_HANDLE_PARAM uint8 row,uint8 col,uint8 height,uint16 value,uint16 max)
+{
+	uint16 rows;
+	uint8 partialCode = ' ';
+	uint8 i;
+
+	if((max == 0) || (height > (row + 1)))
+		return;
+	if(value > max)
+		value = max;
+
+	rows = (uint16)(((uint32)value * height * 8) / max);	/* filled dot rows */
+
+	if((rows % 8) != 0)
+	{
+		partialCode = LCD_loadGlyph(LCD_HANDLE_ARG g_verticalBarGlyphs[(rows % 8) - 1]);
+	}
+
+	for(i=0;i<height;i++)
+	{
+		LCD_goToRowColumn(LCD_HANDLE_ARG row - i,col);
+		if(rows >= 8)
+		{
+			LCD_displayCharacter(LCD_HANDLE_ARG LCD_FULL_BLOCK);
+			rows -= 8;
+		}
+		else if(rows != 0)
+		{
+			LCD_displayCharacter(LCD_HANDLE_ARG partialCode);
+			rows = 0;
+		}
+		else
+		{
+			LCD_displayCharacter(LCD_HANDLE_ARG ' ');
+		}
+	}
+}
@@ -30,6 +30,43 @@
 #define UPPER_PORT_PINS
 #endif
 
+/* Busy flag mode: the busy flag is read through the RW pin to know when the LCD finished
+ * its last operation, otherwise fixed execution time delays are used */
+#define LCD_BUSY_FLAG
+#undef LCD_BUSY_FLAG  /* Remove This line in case you want to read the busy flag */
+
+/* LCD size (rows 2 and 3 of 4 line LCDs continue rows 0 and 1 after LCD_COLS characters) */
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+/* Frame buffer mode: the application writes in a RAM copy of the screen and LCD_refresh
+ * sends only the characters that changed since the last refresh */
+#define LCD_FRAMEBUFFER
+#undef LCD_FRAMEBUFFER  /* Remove This line in case you want to use the frame buffer */
+
+/* Asynchronous mode: LCD_sendCommand and LCD_displayCharacter (and all functions using them)
+ * only queue the operation , a timer interrupt every LCD_ASYNC_TICK_US sends one operation
+ * (the application waits only when the queue is full , with the interrupts disabled it sends
+ * the oldest operations itself) */
+#define LCD_ASYNC
+#undef LCD_ASYNC  /* Remove This line in case you want to use the asynchronous mode */
+
+/* Multi display mode: the pins of every LCD are given in a handle (LCD_HandleType) passed
+ * to every function as first argument, otherwise the pins below are used (one LCD) */
+#define LCD_MULTI_DISPLAY
+#undef LCD_MULTI_DISPLAY  /* Remove This line in case you want to use more than one LCD */
+
+#if (defined(LCD_MULTI_DISPLAY) && (defined(LCD_FRAMEBUFFER) || defined(LCD_ASYNC)))
+#error "LCD frame buffer and asynchronous modes support one LCD only"
+#endif
+
+#define LCD_ASYNC_TICK_US 100   /* timer interrupt period configured in LCD_asyncInit */
+#define LCD_QUEUE_SIZE 64       /* number of queued operations (power of 2 , maximum 128) */
+
+#ifdef LCD_ASYNC
+#include "timers.h"
+#endif
+
 /* LCD HW Pins */
 #define RS PB0
 #define RW PB1
@@ -39,6 +76,7 @@
 
 #define LCD_DATA_PORT PORTA
 #define LCD_DATA_PORT_DIR DDRA
+#define LCD_DATA_PORT_IN PINA
 
 /* LCD Commands */
 #define CLEAR_COMMAND 0x01
@@ -48,17 +86,88 @@
 #define CURSOR_OFF 0x0C
 #define CURSOR_ON 0x0E
 #define SET_CURSOR_LOCATION 0x80
+#define SET_CGRAM_ADDRESS 0x40
+
+/* Number of custom characters in the CGRAM (5x8 dots) */
+#define LCD_GLYPHS 8
+
+/* ROM character of a full 5x8 block */
+#define LCD_FULL_BLOCK 0xFF
+
+/* Handle argument of the functions (nothing in case of one LCD) */
+#ifdef LCD_MULTI_DISPLAY
+#define LCD_HANDLE_PARAM     LCD_HandleType * lcd_Ptr,
+#define LCD_HANDLE_ONLY      LCD_HandleType * lcd_Ptr
+#define LCD_HANDLE_ARG       lcd_Ptr,
+#define LCD_HANDLE_ARG_ONLY  lcd_Ptr
+#else
+#define LCD_HANDLE_PARAM
+#define LCD_HANDLE_ONLY      void
+#define LCD_HANDLE_ARG
+#define LCD_HANDLE_ARG_ONLY
+#endif
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+#ifdef LCD_MULTI_DISPLAY
+typedef struct
+{
+	volatile uint8 * s_ctrlPort;     /* port of RS , RW and E pins (e.g. &PORTB) */
+	volatile uint8 * s_ctrlPortDir;  /* direction register of the control port (e.g. &DDRB) */
+	volatile uint8 * s_dataPort;     /* data port (e.g. &PORTA) */
+	volatile uint8 * s_dataPortDir;  /* direction register of the data port (e.g. &DDRA) */
+	volatile uint8 * s_dataPortIn;   /* input register of the data port (e.g. &PINA) */
+	uint8 s_rsMask;                  /* (1<<pin) of RS */
+	uint8 s_rwMask;                  /* (1<<pin) of RW */
+	uint8 s_enableMask;              /* (1<<pin) of E , LCDs may share all pins except E */
+	uint8 s_dataBitsMode;            /* 4 or 8 */
+	uint8 s_upperPortPins;           /* in case of 4 bits mode: TRUE for pins 7:4 , FALSE for pins 3:0 */
+	uint8 s_cols;                    /* number of columns */
+
+	/* used by the driver (CGRAM glyph cache) , initialized by LCD_init */
+	const uint8 * s_glyphResident[LCD_GLYPHS];
+	uint16 s_glyphLastUse[LCD_GLYPHS];
+	uint16 s_glyphClock;
+}LCD_HandleType;
+#endif
 
 /*******************************************************************************
  *                      Functions Prototypes                                   *
  *******************************************************************************/
-void LCD_init(void);
-void LCD_sendCommand(uint8 command);
-void LCD_displayCharacter(uint8 data);
-void LCD_displayString(const char *Str);
-void LCD_clearScreen(void);
-void LCD_displayStringRowColumn(uint8 row,uint8 col,const char *Str);
-void LCD_goToRowColumn(uint8 row,uint8 col);
-void LCD_integerToString(int data);
+void LCD_init(LCD_HANDLE_ONLY);
+void LCD_sendCommand(LCD_HANDLE_PARAM uint8 command);
+void LCD_displayCharacter(LCD_HANDLE_PARAM uint8 data);
+void LCD_displayString(LCD_HANDLE_PARAM const char *Str);
+void LCD_clearScreen(LCD_HANDLE_ONLY);
+void LCD_displayStringRowColumn(LCD_HANDLE_PARAM uint8 row,uint8 col,const char *Str);
+void LCD_goToRowColumn(LCD_HANDLE_PARAM uint8 row,uint8 col);
+void LCD_integerToString(LCD_HANDLE_PARAM int data);
+uint8 LCD_formatUnsigned(char *buff,uint32 value,uint8 width,char pad);
+uint8 LCD_formatSigned(char *buff,sint32 value,uint8 width,char pad);
+uint8 LCD_formatHex(char *buff,uint32 value,uint8 width,char pad);
+uint8 LCD_formatFixedPoint(char *buff,sint32 value,uint8 decimals,uint8 width,char pad);
+void LCD_displayUnsigned(LCD_HANDLE_PARAM uint32 value,uint8 width,char pad);
+void LCD_displaySigned(LCD_HANDLE_PARAM sint32 value,uint8 width,char pad);
+void LCD_displayHex(LCD_HANDLE_PARAM uint32 value,uint8 width,char pad);
+void LCD_displayFixedPoint(LCD_HANDLE_PARAM sint32 value,uint8 decimals,uint8 width,char pad);
+void LCD_uploadGlyph(LCD_HANDLE_PARAM uint8 slot,const uint8 *pattern);
+uint8 LCD_loadGlyph(LCD_HANDLE_PARAM const uint8 *pattern);
+void LCD_displayHorizontalBar(LCD_HANDLE_PARAM uint8 row,uint8 col,uint8 width,uint16 value,uint16 max);
+void LCD_displayVerticalBar(LCD_HANDLE_PARAM uint8 row,uint8 col,uint8 height,uint16 value,uint16 max);
+
+#ifdef LCD_ASYNC
+void LCD_asyncInit(const timer_ConfigType * config_Ptr);
+void LCD_asyncTick(void);
+uint8 LCD_isIdle(void);
+#endif
+
+#ifdef LCD_FRAMEBUFFER
+void LCD_bufferClear(void);
+void LCD_bufferWriteCharacter(uint8 row,uint8 col,uint8 data);
+void LCD_bufferWriteString(uint8 row,uint8 col,const char *Str);
+void LCD_refresh(void);
+#endif
 
 #endif /* LCD_H_ */
@@ -0,0 +1,194 @@
+/******************************************************************************
+ *
+ * Module: Profiler
+ *
+ * File Name: profiler.c
+ *
+ * Description: Source file for the cycle counting profiler (uses timer1)
+ *
+ * Author: Ganna Ahmed
+ *
+ *******************************************************************************/
+
+#include "profiler.h"
+#include "timers.h"
+
+#ifdef PROFILING
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* High 16 bits of the cycle counter (timer1 overflows) */
+static volatile uint16 g_profOverflows = 0;
+
+/* Cycles taken by PROF_begin + PROF_end themselves , subtracted from every measurement */
+static uint32 g_profOverhead = 0;
+
+/* Start cycle of every zone */
+static uint32 g_profStart[PROF_MAX_ZONES];
+
+static PROF_ZoneType g_profZones[PROF_MAX_ZONES];
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*************************************************************************************************
+ *  [Function Name]:    PROF_timerOverflow
+ *  [Description] :		This Function is the timer1 overflow call back, it counts the high 16 bits
+ *                      of the cycle counter
+ *  [Args] :            NONE
+ *  [Returns] :			NONE
+ ***************************************************************************************************/
+
+void PROF_timerOverflow(void)
+{
+	g_profOverflows++;
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    PROF_init
+ *  [Description] :		This Function initializes the profiler
+ *                      1-Start timer1 in normal mode with no prescaler (one count every CPU cycle)
+ *                      2-Count timer1 overflows to extend the counter to 32 bits
+ *                      3-Measure the overhead of an empty zone
+ *                      4-Clear the statistics of all zones
+ *  [Args] :            NONE
+ *  [Returns] :			NONE
+ *  [Remarks] :         Global interrupts must be enabled to count the overflows
+ ***************************************************************************************************/
+
+void PROF_init(void)
+{
+	timer_ConfigType config = {1,normal,0,F_CPU_CLOCK,NO_CLOCK_2,0,0};
+
+	g_profOverflows = 0;
+	g_profOverhead = 0;
+
+#ifndef TIMER_STATIC_CALLBACK
+	timer_setEventCallBack(1,TIMER_OVERFLOW,PROF_timerOverflow);
+#endif
+	timer_init(&config);
+
+	/* measure an empty zone, its cycles are the cost of the measurement itself */
+	PROF_reset();
+	PROF_begin(0);
+	PROF_end(0);
+	g_profOverhead = g_profZones[0].s_max;
+	PROF_reset();
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    PROF_getCycles
+ *  [Description] :		This Function returns the number of cycles since PROF_init
+ *  [Args] :            NONE
+ *  [Returns] :			uint32
+ *                         cycle count
+ ***************************************************************************************************/
+
+uint32 PROF_getCycles(void)
+{
+	uint16 low;
+	uint16 high;
+
+	ATOMIC_BEGIN();
+	low = TCNT1;
+	high = g_profOverflows;
+
+	/* The counter overflowed but the interrupt is not served yet (interrupts are disabled here),
+	 * a small low value means it was read after the overflow */
+	if(BIT_IS_SET(TIFR,TOV1) && (low < 0x8000))
+	{
+		high++;
+	}
+	ATOMIC_END();
+
+	return ((uint32)high<<16) | low;
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    PROF_begin
+ *  [Description] :		This Function stores the start cycle of a zone (use PROF_BEGIN macro)
+ *  [Args] :            uint8 id
+ *                         zone id (0 to PROF_MAX_ZONES-1)
+ *  [Returns] :			NONE
+ ***************************************************************************************************/
+
+void PROF_begin(uint8 id)
+{
+	if(id >= PROF_MAX_ZONES)
+		return;
+
+	g_profStart[id] = PROF_getCycles();
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    PROF_end
+ *  [Description] :		This Function adds the cycles since PROF_begin of the same zone to the zone
+ *                      count, total and maximum (use PROF_END macro)
+ *  [Args] :            uint8 id
+ *                         zone id (0 to PROF_MAX_ZONES-1)
+ *  [Returns] :			NONE
+ ***************************************************************************************************/
+
+void PROF_end(uint8 id)
+{
+	uint32 cycles = PROF_getCycles();
+
+	if(id >= PROF_MAX_ZONES)
+		return;
+
+	cycles -= g_profStart[id];
+	cycles = (cycles > g_profOverhead) ? (cycles - g_profOverhead) : 0;
+
+	if(g_profZones[id].s_count < 0xFFFF)
+	{
+		g_profZones[id].s_count++;
+		g_profZones[id].s_total += cycles;
+	}
+	if(cycles > g_profZones[id].s_max)
+	{
+		g_profZones[id].s_max = cycles;
+	}
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    PROF_getZone
+ *  [Description] :		This Function copies the statistics of a zone
+ *                      (mean cycles = s_total / s_count)
+ *  [Args] :            uint8 id
+ *                         zone id (0 to PROF_MAX_ZONES-1)
+ *                      Pointer to Struct PROF_ZoneType
+ *                         the statistics will be copied to it
+ *  [Returns] :			NONE
+ ***************************************************************************************************/
+
+void PROF_getZone(uint8 id,PROF_ZoneType * zone_Ptr)
+{
+	if(id >= PROF_MAX_ZONES)
+		return;
+
+	*zone_Ptr = g_profZones[id];
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    PROF_reset
+ *  [Description] :		This Function clears the statistics of all zones
+ *  [Args] :            NONE
+ *  [Returns] :			NONE
+ ***************************************************************************************************/
+
+void PROF_reset(void)
+{
+	uint8 id;
+
+	for(id=0;id<PROF_MAX_ZONES;id++)
+	{
+		g_profZones[id].s_count = 0;
+		g_profZones[id].s_total = 0;
+		g_profZones[id].s_max = 0;
+	}
+}
+
+#endif /* PROFILING */
@@ -0,0 +1,80 @@
+/******************************************************************************
+ *
+ * Module: Profiler
+ *
+ * File Name: profiler.h
+ *
+ * Description: header file for the cycle counting profiler (uses timer1)
+ *
+ * Author: Ganna Ahmed
+ *
+ *******************************************************************************/
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include "std_types.h"
+#include "common_macros.h"
+#include "micro_configurations.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Profiling zones: timer1 runs with no prescaler as a cycle counter and is extended to
+ * 32 bits by its overflow interrupt, so timer1 can't be used by the application meanwhile
+ * When PROFILING is not defined PROF_BEGIN and PROF_END generate no code */
+#define PROFILING
+#undef PROFILING  /* Remove This line in case you want to profile the code */
+
+/* Number of profiling zones (zone ids from 0 to PROF_MAX_ZONES-1) */
+#define PROF_MAX_ZONES 8
+
+#ifdef PROFILING
+#define PROF_BEGIN(id) PROF_begin(id)
+#define PROF_END(id)   PROF_end(id)
+#else
+#define PROF_BEGIN(id)
+#define PROF_END(id)
+#endif
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct
+{
+	uint16 s_count;     /* number of measured runs of the zone */
+	uint32 s_total;     /* total cycles of all runs */
+	uint32 s_max;       /* cycles of the longest run */
+}PROF_ZoneType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+#ifdef PROFILING
+/* Function starts timer1 as cycle counter, measures the profiling overhead and clears all zones */
+void PROF_init(void);
+
+/* Function counts timer1 overflows (the high 16 bits of the cycle counter)
+ * In case of compile time binding of timer call backs call it from TIMER1_OVF_HOOK */
+void PROF_timerOverflow(void);
+
+/* Function returns the number of cycles since PROF_init */
+uint32 PROF_getCycles(void);
+
+/* Function stores the start cycle of a zone */
+void PROF_begin(uint8 id);
+
+/* Function adds the cycles since PROF_begin of the same zone to its statistics */
+void PROF_end(uint8 id);
+
+/* Function copies the statistics of a zone */
+void PROF_getZone(uint8 id,PROF_ZoneType * zone_Ptr);
+
+/* Function clears the statistics of all zones */
+void PROF_reset(void);
+#endif
+
+#endif /* PROFILER_H_ */
@@ -0,0 +1,551 @@
+/******************************************************************************
+ *
+ * Module: SPI Flash
+ *
+ * File Name: spi_flash.c
+ *
+ * Description: Source file for the JEDEC SPI NOR flash memory and the append only logger
+ *
+ * Author: Ganna Ahmed
+ *
+ *******************************************************************************/
+
+#include "spi_flash.h"
+
+/* States of the logger page which is not being filled */
+#define LOG_PAGE_FREE 0
+#define LOG_PAGE_FULL 1       /* waiting until it is programmed */
+
+/* Background steps of the logger (the transaction of the step is queued or its result is kept) */
+#define LOG_STEP_NONE 0
+#define LOG_STEP_STATUS 1     /* status register read */
+#define LOG_STEP_ERASE 2      /* write enable then sector erase */
+#define LOG_STEP_PROGRAM 3    /* write enable then page program */
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static SPI_DeviceType g_flashDevice;
+
+/* Command and address of the blocking commands */
+static uint8 g_flashHeader[5];
+
+/* Logger pages , g_logPage[g_logFill] is filled while the other one is programmed */
+static uint8 g_logPage[2][FLASH_PAGE_SIZE];
+static uint8 g_logFill = 0;
+static uint16 g_logIndex = 0;            /* bytes in the page being filled */
+static uint8 g_logState = LOG_PAGE_FREE; /* state of the other page */
+static uint8 g_logStep = LOG_STEP_NONE;
+
+static uint32 g_logAddress = 0;          /* flash address of the next programmed page */
+static uint32 g_logEnd = 0;
+static uint32 g_logErasedEnd = 0;        /* sectors are erased up to this address */
+
+/* Background transactions (status read , write enable and sector erase or page program) ,
+ * a transaction is submitted again only after its s_done is TRUE */
+static const uint8 g_logReadStatus = FLASH_READ_STATUS;
+static const uint8 g_logWriteEnable = FLASH_WRITE_ENABLE;
+static uint8 g_logStatus;
+static uint8 g_logHeader[4];
+static SPI_TransactionType g_logStatusTransaction;
+static SPI_TransactionType g_logWriteEnableTransaction;
+static SPI_TransactionType g_logWriteTransaction;
+
+/*******************************************************************************
+ *                      Private Functions Prototypes                           *
+ *******************************************************************************/
+
+static void FLASH_setCommand(uint8 * header_Ptr,uint8 command,uint32 address);
+static void FLASH_command(uint8 header_len,const uint8 * tx_Ptr,uint8 * rx_Ptr,uint16 len);
+static void FLASH_writeEnable(void);
+static void FLASH_logSwap(void);
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/*************************************************************************************************
+ *  [Function Name]:    FLASH_setCommand
+ *  [Description] :		This Function writes a command and its 24-bit address (most significant first)
+ *  [Args] :            uint8 * header_Ptr
+ *                         buffer of 4 bytes at least
+ *                      uint8 command
+ *                      uint32 address
+ *  [Returns] :			NONE
+ ***************************************************************************************************/
+
+static void FLASH_setCommand(uint8 * header_Ptr,uint8 command,uint32 address)
+{
+	header_Ptr[0] = command;
+	header_Ptr[1] = (uint8)(address>>16);
+	header_Ptr[2] = (uint8)(address>>8);
+	header_Ptr[3] = (uint8)address;
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    FLASH_command
+ *  [Description] :		This Function sends the command in g_flashHeader followed by the data bytes
+ *                      in one selection of the flash and waits until it is done
+ *  [Args] :            uint8 header_len
+ *                         number of command bytes in g_flashHeader
+ *                      const uint8 * tx_Ptr , uint8 * rx_Ptr , uint16 len
+ *                         data bytes (len is 0 for a command without data)
+ *  [Returns] :			NONE
+ ***************************************************************************************************/
+
+static void FLASH_command(uint8 header_len,const uint8 * tx_Ptr,uint8 * rx_Ptr,uint16 len)
+{
+	SPI_TransactionType transaction;
+
+	transaction.s_device = &g_flashDevice;
+	transaction.s_header = g_flashHeader;
+	transaction.s_headerLen = header_len;
+	transaction.s_tx = tx_Ptr;
+	transaction.s_rx = rx_Ptr;
+	transaction.s_len = len;
+	transaction.s_callBack = NULL_PTR;
+
+	/* Queue is full , wait for a free entry */
+	while(SPI_busSubmit(&transaction) == ERROR){}
+
+	while(!transaction.s_done){}
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    FLASH_writeEnable
+ *  [Description] :		This Function sets the write enable latch (needed before every program or erase)
+ *  [Args] :            NONE
+ *  [Returns] :			NONE
+ ***************************************************************************************************/
+
+static void FLASH_writeEnable(void)
+{
+	g_flashHeader[0] = FLASH_WRITE_ENABLE;
+	FLASH_command(1,NULL_PTR,NULL_PTR,0);
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    FLASH_logSwap
+ *  [Description] :		This Function hands the full page to the programming side and starts filling
+ *                      the other page
+ *  [Args] :            NONE
+ *  [Returns] :			NONE
+ *  [Remarks] :         The other page must be free
+ ***************************************************************************************************/
+
+static void FLASH_logSwap(void)
+{
+	g_logFill ^= 1;
+	g_logIndex = 0;
+	g_logState = LOG_PAGE_FULL;
+	FLASH_logProcess();
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*************************************************************************************************
+ *  [Function Name]:    FLASH_init
+ *  [Description] :		This Function initializes the flash
+ *                      1-Initialize the flash handle on the SPI bus
+ *                      2-Release the flash from deep power down
+ *  [Args] :            volatile uint8 * cs_port , volatile uint8 * cs_port_dir , uint8 cs_pin
+ *                         chip select pin of the flash
+ *                      Pointer to Struct SPI_ConfigType
+ *                         SPI mode 0 or 3 , the flash supports the fastest SPI clock
+ *  [Returns] :			NONE
+ *  [Remarks] :         SPI_initMaster must be called first
+ ***************************************************************************************************/
+
+void FLASH_init(volatile uint8 * cs_port,volatile uint8 * cs_port_dir,uint8 cs_pin,const SPI_ConfigType * config_Ptr)
+{
+	SPI_deviceInit(&g_flashDevice,cs_port,cs_port_dir,cs_pin,config_Ptr);
+
+	g_flashHeader[0] = FLASH_RELEASE_POWER_DOWN;
+	FLASH_command(1,NULL_PTR,NULL_PTR,0);
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    FLASH_readJedecId
+ *  [Description] :		This Function reads the JEDEC identification of the flash
+ *  [Args] :            NONE
+ *  [Returns] :			uint32
+ *                         manufacturer id (bits 23:16) , memory type (bits 15:8) , capacity (bits 7:0)
+ ***************************************************************************************************/
+
+uint32 FLASH_readJedecId(void)
+{
+	uint8 id[3];
+
+	g_flashHeader[0] = FLASH_READ_JEDEC_ID;
+	FLASH_command(1,NULL_PTR,id,3);
+
+	return ((uint32)id[0]<<16) | ((uint16)id[1]<<8) | id[2];
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    FLASH_readStatus
+ *  [Description] :		This Function reads the status register of the flash
+ *  [Args] :            NONE
+ *  [Returns] :			uint8
+ *                         status register (FLASH_WIP , FLASH_WEL bits)
+ ***************************************************************************************************/
+
+uint8 FLASH_readStatus(void)
+{
+	uint8 status;
+
+	g_flashHeader[0] = FLASH_READ_STATUS;
+	FLASH_command(1,NULL_PTR,&status,1);
+
+	return status;
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    FLASH_isBusy
+ *  [Description] :		This Function checks if a program or erase is in progress
+ *  [Args] :            NONE
+ *  [Returns] :			uint8
+ *                         TRUE if the flash is busy , FALSE otherwise
+ ***************************************************************************************************/
+
+uint8 FLASH_isBusy(void)
+{
+	return BIT_IS_SET(FLASH_readStatus(),FLASH_WIP) ? TRUE : FALSE;
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    FLASH_waitReady
+ *  [Description] :		This Function polls the status register until the flash is not busy
+ *  [Args] :            NONE
+ *  [Returns] :			NONE
+ ***************************************************************************************************/
+
+void FLASH_waitReady(void)
+{
+	while(FLASH_isBusy()){}
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    FLASH_read
+ *  [Description] :		This Function reads a block of bytes using the fast read command
+ *                      (the whole block is read in one command , crossing pages and sectors)
+ *  [Args] :            uint32 address
+ *                      uint8 * buff_Ptr
+ *                      uint16 len
+ *  [Returns] :			NONE
+ ***************************************************************************************************/
+
+void FLASH_read(uint32 address,uint8 * buff_Ptr,uint16 len)
+{
+	if(len == 0)
+		return;
+
+	FLASH_waitReady();
+	FLASH_setCommand(g_flashHeader,FLASH_FAST_READ,address);
+	g_flashHeader[4] = SPI_DUMMY_BYTE;
+	FLASH_command(5,NULL_PTR,buff_Ptr,len);
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    FLASH_pageProgram
+ *  [Description] :		This Function programs bytes inside one page (the bytes must be erased)
+ *  [Args] :            uint32 address
+ *                      const uint8 * data_Ptr
+ *                      uint16 len
+ *                         1 to FLASH_PAGE_SIZE , the bytes must not cross the end of the page
+ *  [Returns] :			uint8
+ *                         ERROR in case of invalid length
+ *                         SUCCESS otherwise
+ *  [Remarks] :         Returns while the flash programs the page (FLASH_isBusy) , the next
+ *                      command waits for it
+ ***************************************************************************************************/
+
+uint8 FLASH_pageProgram(uint32 address,const uint8 * data_Ptr,uint16 len)
+{
+	if((len == 0) || (((uint16)address & (FLASH_PAGE_SIZE - 1)) + len > FLASH_PAGE_SIZE))
+		return ERROR;
+
+	FLASH_waitReady();
+	FLASH_writeEnable();
+	FLASH_setCommand(g_flashHeader,FLASH_PAGE_PROGRAM,address);
+	FLASH_command(4,data_Ptr,NULL_PTR,len);
+
+	return SUCCESS;
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    FLASH_sectorErase
+ *  [Description] :		This Function erases the sector (FLASH_SECTOR_SIZE bytes) of an address
+ *  [Args] :            uint32 address
+ *  [Returns] :			NONE
+ *  [Remarks] :         Returns while the flash erases the sector
+ ***************************************************************************************************/
+
+void FLASH_sectorErase(uint32 address)
+{
+	FLASH_waitReady();
+	FLASH_writeEnable();
+	FLASH_setCommand(g_flashHeader,FLASH_SECTOR_ERASE,address);
+	FLASH_command(4,NULL_PTR,NULL_PTR,0);
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    FLASH_blockErase
+ *  [Description] :		This Function erases the block (FLASH_BLOCK_SIZE bytes) of an address
+ *  [Args] :            uint32 address
+ *  [Returns] :			NONE
+ *  [Remarks] :         Returns while the flash erases the block
+ ***************************************************************************************************/
+
+void FLASH_blockErase(uint32 address)
+{
+	FLASH_waitReady();
+	FLASH_writeEnable();
+	FLASH_setCommand(g_flashHeader,FLASH_BLOCK_ERASE,address);
+	FLASH_command(4,NULL_PTR,NULL_PTR,0);
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    FLASH_chipErase
+ *  [Description] :		This Function erases the whole flash
+ *  [Args] :            NONE
+ *  [Returns] :			NONE
+ *  [Remarks] :         Returns while the flash is erased (it takes seconds)
+ ***************************************************************************************************/
+
+void FLASH_chipErase(void)
+{
+	FLASH_waitReady();
+	FLASH_writeEnable();
+	g_flashHeader[0] = FLASH_CHIP_ERASE;
+	FLASH_command(1,NULL_PTR,NULL_PTR,0);
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    FLASH_logInit
+ *  [Description] :		This Function starts an append only log in a flash area , the sectors are
+ *                      erased by the logger just before they are written
+ *  [Args] :            uint32 start_address
+ *                         first address of the log , aligned to FLASH_SECTOR_SIZE
+ *                      uint32 end_address
+ *                         address after the log area
+ *  [Returns] :			uint8
+ *                         ERROR in case of invalid area
+ *                         SUCCESS otherwise
+ *  [Remarks] :         Must not be called while log pages are programmed (call FLASH_logFlush first) ,
+ *                      the other program and erase functions must not be used while the log is written
+ ***************************************************************************************************/
+
+uint8 FLASH_logInit(uint32 start_address,uint32 end_address)
+{
+	if((start_address & (FLASH_SECTOR_SIZE - 1)) || (end_address <= start_address))
+		return ERROR;
+
+	g_logFill = 0;
+	g_logIndex = 0;
+	g_logState = LOG_PAGE_FREE;
+	g_logStep = LOG_STEP_NONE;
+	g_logAddress = start_address;
+	g_logEnd = end_address;
+	g_logErasedEnd = start_address;
+
+	g_logStatusTransaction.s_device = &g_flashDevice;
+	g_logStatusTransaction.s_header = &g_logReadStatus;
+	g_logStatusTransaction.s_headerLen = 1;
+	g_logStatusTransaction.s_tx = NULL_PTR;
+	g_logStatusTransaction.s_rx = &g_logStatus;
+	g_logStatusTransaction.s_len = 1;
+	g_logStatusTransaction.s_callBack = NULL_PTR;
+	g_logStatusTransaction.s_done = TRUE;
+
+	g_logWriteEnableTransaction.s_device = &g_flashDevice;
+	g_logWriteEnableTransaction.s_header = &g_logWriteEnable;
+	g_logWriteEnableTransaction.s_headerLen = 1;
+	g_logWriteEnableTransaction.s_len = 0;
+	g_logWriteEnableTransaction.s_callBack = NULL_PTR;
+	g_logWriteEnableTransaction.s_done = TRUE;
+
+	/* Sector erase (no data) or page program , set when it is submitted */
+	g_logWriteTransaction.s_device = &g_flashDevice;
+	g_logWriteTransaction.s_header = g_logHeader;
+	g_logWriteTransaction.s_headerLen = 4;
+	g_logWriteTransaction.s_rx = NULL_PTR;
+	g_logWriteTransaction.s_callBack = NULL_PTR;
+	g_logWriteTransaction.s_done = TRUE;
+
+	return SUCCESS;
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    FLASH_logAppend
+ *  [Description] :		This Function copies bytes to the end of the log , every full page is
+ *                      programmed in the background while the other page is filled
+ *  [Args] :            const uint8 * data_Ptr
+ *                      uint16 len
+ *  [Returns] :			uint16
+ *                         number of bytes stored , less than len when both pages are full (the flash
+ *                         is slower than the data) or the log area is full
+ *  [Remarks] :         Call it from the main loop only
+ ***************************************************************************************************/
+
+uint16 FLASH_logAppend(const uint8 * data_Ptr,uint16 len)
+{
+	uint16 stored = 0;
+	uint8 * page_Ptr;
+
+	FLASH_logProcess();
+
+	while(stored < len)
+	{
+		if(g_logIndex == FLASH_PAGE_SIZE)
+		{
+			if(g_logState != LOG_PAGE_FREE)
+				break;	/* the previous page is not programmed yet */
+
+			FLASH_logSwap();
+		}
+
+		page_Ptr = g_logPage[g_logFill];
+		while((g_logIndex < FLASH_PAGE_SIZE) && (stored < len))
+		{
+			page_Ptr[g_logIndex++] = data_Ptr[stored++];
+		}
+	}
+
+	/* Start programming a page filled by this call at once */
+	if((g_logIndex == FLASH_PAGE_SIZE) && (g_logState == LOG_PAGE_FREE))
+	{
+		FLASH_logSwap();
+	}
+
+	return stored;
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    FLASH_logProcess
+ *  [Description] :		This Function advances the background programming of the log by one step ,
+ *                      it only queues bus transactions and checks the done ones (never waits)
+ *                      1-A programmed page becomes free , an erased sector extends the erased area
+ *                      2-The status register is read until the flash is ready
+ *                      3-The next sector is erased if the page is its first page , otherwise the
+ *                        full page is programmed (write enable and the command are queued together)
+ *  [Args] :            NONE
+ *  [Returns] :			NONE
+ *  [Remarks] :         Called by FLASH_logAppend , call it from the main loop too so a full page
+ *                      is programmed without waiting for the next append
+ *                      A transaction which completes with ERROR (or can't be queued) is repeated
+ *                      in the next call
+ ***************************************************************************************************/
+
+void FLASH_logProcess(void)
+{
+	uint8 writeStep;
+
+	/* A background transaction is still queued or on the bus */
+	if(!g_logStatusTransaction.s_done || !g_logWriteEnableTransaction.s_done || !g_logWriteTransaction.s_done)
+		return;
+
+	if(g_logStep == LOG_STEP_PROGRAM)
+	{
+		if((g_logWriteEnableTransaction.s_status == SUCCESS) && (g_logWriteTransaction.s_status == SUCCESS))
+		{
+			g_logAddress += FLASH_PAGE_SIZE;
+			g_logState = LOG_PAGE_FREE;
+		}
+		g_logStep = LOG_STEP_NONE;
+	}
+	else if(g_logStep == LOG_STEP_ERASE)
+	{
+		if((g_logWriteEnableTransaction.s_status == SUCCESS) && (g_logWriteTransaction.s_status == SUCCESS))
+		{
+			g_logErasedEnd += FLASH_SECTOR_SIZE;
+		}
+		g_logStep = LOG_STEP_NONE;
+	}
+
+	if((g_logState != LOG_PAGE_FULL) || (g_logAddress >= g_logEnd))
+		return;
+
+	/* No status read yet , or the flash is still busy with the previous erase or program */
+	if((g_logStep != LOG_STEP_STATUS) || (g_logStatusTransaction.s_status == ERROR) || BIT_IS_SET(g_logStatus,FLASH_WIP))
+	{
+		g_logStep = (SPI_busSubmit(&g_logStatusTransaction) == SUCCESS) ? LOG_STEP_STATUS : LOG_STEP_NONE;
+		return;
+	}
+
+	if(g_logAddress >= g_logErasedEnd)
+	{
+		FLASH_setCommand(g_logHeader,FLASH_SECTOR_ERASE,g_logErasedEnd);
+		g_logWriteTransaction.s_tx = NULL_PTR;
+		g_logWriteTransaction.s_len = 0;
+		writeStep = LOG_STEP_ERASE;		/* the page is programmed after the erase */
+	}
+	else
+	{
+		FLASH_setCommand(g_logHeader,FLASH_PAGE_PROGRAM,g_logAddress);
+		g_logWriteTransaction.s_tx = g_logPage[g_logFill ^ 1];
+		g_logWriteTransaction.s_len = FLASH_PAGE_SIZE;
+		writeStep = LOG_STEP_PROGRAM;
+	}
+
+	/* Both transactions are queued or none , in case the queue has no room for both the flash
+	 * stays ready (LOG_STEP_STATUS) and they are queued in the next call */
+	ATOMIC_BEGIN();
+	if((SPI_busFree() >= 2) && (SPI_busSubmit(&g_logWriteEnableTransaction) == SUCCESS))
+	{
+		g_logStep = (SPI_busSubmit(&g_logWriteTransaction) == SUCCESS) ? writeStep : LOG_STEP_NONE;
+	}
+	ATOMIC_END();
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    FLASH_logFlush
+ *  [Description] :		This Function programs the page being filled (the rest of the page is left
+ *                      erased , 0xFF) and waits until all log pages are programmed
+ *  [Args] :            NONE
+ *  [Returns] :			NONE
+ *  [Remarks] :         The next appended bytes start in a new page
+ ***************************************************************************************************/
+
+void FLASH_logFlush(void)
+{
+	if(g_logIndex != 0)
+	{
+		while(g_logState != LOG_PAGE_FREE)
+		{
+			FLASH_logProcess();
+			if(g_logAddress >= g_logEnd)
+				return;		/* log area is full */
+		}
+
+		while(g_logIndex < FLASH_PAGE_SIZE)
+		{
+			g_logPage[g_logFill][g_logIndex++] = 0xFF;
+		}
+		FLASH_logSwap();
+	}
+
+	while(g_logState != LOG_PAGE_FREE)
+	{
+		FLASH_logProcess();
+		if((g_logState == LOG_PAGE_FULL) && (g_logAddress >= g_logEnd))
+			return;
+	}
+	FLASH_waitReady();
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    FLASH_logGetAddress
+ *  [Description] :		This Function returns the flash address where the next log page is programmed
+ *  [Args] :            NONE
+ *  [Returns] :			uint32
+ *                         address of the next page
+ ***************************************************************************************************/
+
+uint32 FLASH_logGetAddress(void)
+{
+	return g_logAddress;
+}
@@ -0,0 +1,67 @@
+/******************************************************************************
+ *
+ * Module: SPI Flash
+ *
+ * File Name: spi_flash.h
+ *
+ * Description: Header file for the JEDEC SPI NOR flash memory and the append only logger
+ *
+ * Author: Ganna Ahmed
+ *
+ *******************************************************************************/
+
+#ifndef SPI_FLASH_H_
+#define SPI_FLASH_H_
+
+#include "std_types.h"
+#include "spi_bus.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+#define FLASH_PAGE_SIZE 256UL       /* bytes programmed by one page program command */
+#define FLASH_SECTOR_SIZE 4096UL    /* bytes erased by the sector erase command */
+#define FLASH_BLOCK_SIZE 65536UL    /* bytes erased by the block erase command */
+
+/* JEDEC commands (24-bit addresses) */
+#define FLASH_WRITE_ENABLE 0x06
+#define FLASH_READ_STATUS 0x05
+#define FLASH_READ_DATA 0x03
+#define FLASH_FAST_READ 0x0B        /* followed by one dummy byte */
+#define FLASH_PAGE_PROGRAM 0x02
+#define FLASH_SECTOR_ERASE 0x20
+#define FLASH_BLOCK_ERASE 0xD8
+#define FLASH_CHIP_ERASE 0xC7
+#define FLASH_READ_JEDEC_ID 0x9F
+#define FLASH_RELEASE_POWER_DOWN 0xAB
+
+/* Status register bits */
+#define FLASH_WIP 0    /* write (program or erase) in progress */
+#define FLASH_WEL 1    /* write enable latch */
+
+#define ERROR 0
+#define SUCCESS 1
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+void FLASH_init(volatile uint8 * cs_port,volatile uint8 * cs_port_dir,uint8 cs_pin,const SPI_ConfigType * config_Ptr);
+uint32 FLASH_readJedecId(void);
+uint8 FLASH_readStatus(void);
+uint8 FLASH_isBusy(void);
+void FLASH_waitReady(void);
+void FLASH_read(uint32 address,uint8 * buff_Ptr,uint16 len);
+uint8 FLASH_pageProgram(uint32 address,const uint8 * data_Ptr,uint16 len);
+void FLASH_sectorErase(uint32 address);
+void FLASH_blockErase(uint32 address);
+void FLASH_chipErase(void);
+
+uint8 FLASH_logInit(uint32 start_address,uint32 end_address);
+uint16 FLASH_logAppend(const uint8 * data_Ptr,uint16 len);
+void FLASH_logProcess(void);
+void FLASH_logFlush(void);
+uint32 FLASH_logGetAddress(void);
+
+#endif /* SPI_FLASH_H_ */
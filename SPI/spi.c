@@ -0,0 +1,482 @@
+/******************************************************************************
+ *
+ * Module: SPI
+ *
+ * File Name: spi.c
+ *
+ * Description: Source file for the SPI AVR driver
+ *
+ * Author: Ganna Ahmed
+ *
+ *******************************************************************************/
+
+#include "spi.h"
+
+#ifdef SPI_SLAVE
+/* Pin , sense bits , flag and vector of the external interrupt wired to SS */
+#if (SPI_SS_INT == 0)
+#define SPI_SS_INT_ENABLE INT0
+#define SPI_SS_INT_FLAG INTF0
+#define SPI_SS_INT_VECT INT0_vect
+#elif (SPI_SS_INT == 1)
+#define SPI_SS_INT_ENABLE INT1
+#define SPI_SS_INT_FLAG INTF1
+#define SPI_SS_INT_VECT INT1_vect
+#elif (SPI_SS_INT == 2)
+#define SPI_SS_INT_ENABLE INT2
+#define SPI_SS_INT_FLAG INTF2
+#define SPI_SS_INT_VECT INT2_vect
+#else
+#error "SPI SS interrupt must be 0 , 1 or 2"
+#endif
+#endif
+
+#ifndef SPI_SLAVE
+/* One byte of the polled transfer : waits for the byte being shifted , starts the next one
+ * then stores the received byte (the next byte is fetched before the wait) */
+#define SPI_RX_STEP() \
+	do{ while(BIT_IS_CLEAR(SPSR,SPIF)){} SPDR = SPI_DUMMY_BYTE; *rx_Ptr++ = SPDR; }while(0)
+#define SPI_TX_STEP() \
+	do{ next = *tx_Ptr++; while(BIT_IS_CLEAR(SPSR,SPIF)){} SPDR = next; }while(0)
+#define SPI_FULL_STEP() \
+	do{ next = *tx_Ptr++; while(BIT_IS_CLEAR(SPSR,SPIF)){} SPDR = next; *rx_Ptr++ = SPDR; }while(0)
+#endif
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* TRUE while an asynchronous transfer is in progress (always FALSE in slave mode) */
+static volatile uint8 g_spiBusy = FALSE;
+
+#ifndef SPI_SLAVE
+/* Asynchronous transfer state (changed by SPI_transferAsync and the SPI ISR) */
+static const uint8 * volatile g_spiTx = NULL_PTR;
+static uint8 * volatile g_spiRx = NULL_PTR;
+static volatile uint16 g_spiCount = 0;     /* bytes left to send after the byte being shifted */
+
+static void (* volatile g_spiCallBack)(void) = NULL_PTR;
+#else
+/* Response buffers , the SPI ISR sends from g_slaveTxActive while the other one is staged */
+static uint8 g_slaveTxBuffer[2][SPI_SLAVE_BUFFER_SIZE];
+static volatile uint8 g_slaveTxLength[2] = {0,0};
+static volatile uint8 g_slaveTxActive = 0;
+static volatile uint8 g_slaveTxStaged = FALSE;   /* TRUE until the staged response is swapped in */
+
+/* Receive buffers , the SPI ISR stores in g_slaveRxActive while the other one holds the last frame */
+static uint8 g_slaveRxBuffer[2][SPI_SLAVE_BUFFER_SIZE];
+static volatile uint8 g_slaveRxActive = 0;
+static volatile uint8 g_slaveFrameLength = 0;
+static volatile uint8 g_slaveFrameCount = 0;    /* frames completed , changed on every SS rising edge */
+static uint8 g_slaveFrameRead = 0;              /* g_slaveFrameCount of the last frame read */
+
+/* Bytes received in the current frame */
+static volatile uint8 g_slaveIndex = 0;
+#endif
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*************************************************************************************************
+ *  [Function Name]:    SPI_isBusy
+ *  [Description] :		This Function checks if an asynchronous transfer is in progress
+ *  [Args] :            NONE
+ *  [Returns] :			uint8
+ *                         TRUE if a transfer is in progress , FALSE otherwise
+ ***************************************************************************************************/
+
+uint8 SPI_isBusy(void)
+{
+	return g_spiBusy;
+}
+
+#ifndef SPI_SLAVE
+/*************************************************************************************************
+ *  [Function Name]:    SPI_initMaster
+ *  [Description] :		This Function initializes the SPI as master
+ *                      1-Set MOSI , SCK and SS as outputs and MISO as input
+ *                      2-Set required mode (clock polarity and phase) and data order
+ *                      3-Set required clock (SPI2X for the double speed clocks)
+ *  [Args] :            Pointer to Struct SPI_ConfigType
+ *  [Returns] :			NONE
+ *  [Remarks] :         SS stays an output (high) , as an input a low level on it would switch the SPI
+ *                      to slave mode
+ ***************************************************************************************************/
+
+void SPI_initMaster(const SPI_ConfigType * config_Ptr)
+{
+	SPI_PORT_DIR = (SPI_PORT_DIR & ~(1<<SPI_MISO)) | (1<<SPI_SS) | (1<<SPI_MOSI) | (1<<SPI_SCK);
+	SET_BIT(SPI_PORT_OUT,SPI_SS);
+
+	/************************** SPCR Description **************************
+	 * SPIE    = 0 interrupt enabled by the asynchronous transfer only
+	 * SPE     = 1 SPI enable
+	 * DORD    = required data order
+	 * MSTR    = 1 master
+	 * CPOL    = bit 1 of the mode , CPHA = bit 0 of the mode
+	 * SPR1:0  = required clock
+	 ***********************************************************************/
+	SPCR = (1<<SPE) | (1<<MSTR) | ((config_Ptr->s_dataOrder)<<DORD) | ((config_Ptr->s_mode)<<CPHA) | ((config_Ptr->s_clock) & 0x03);
+	SPSR = ((config_Ptr->s_clock)>>2)<<SPI2X;
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    SPI_sendReceiveByte
+ *  [Description] :		This Function sends 1 byte and returns the byte received meanwhile using polling
+ *  [Args] :            uint8 data
+ *  [Returns] :			uint8
+ *                         The received byte
+ ***************************************************************************************************/
+
+uint8 SPI_sendReceiveByte(const uint8 data)
+{
+	while(g_spiBusy){}	/* an asynchronous transfer owns the bus */
+
+	SPDR = data;
+	/* SPIF is set when the byte is shifted, reading SPSR then SPDR clears it */
+	while(BIT_IS_CLEAR(SPSR,SPIF)){}
+	return SPDR;
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    SPI_transfer
+ *  [Description] :		This Function sends and receives a block of bytes using polling
+ *                      The next byte is fetched while the current one is shifted and written to SPDR
+ *                      as soon as SPIF is set (before reading the received byte, it stays in the
+ *                      receive buffer) so the gap between bytes is a few cycles, every direction
+ *                      has its own loop without pointer checks , unrolled by 2 so the 16-bit
+ *                      counter is updated once every two bytes
+ *  [Args] :            const uint8 * tx_Ptr
+ *                         bytes to send (NULL_PTR to send SPI_DUMMY_BYTE)
+ *                      uint8 * rx_Ptr
+ *                         buffer of the received bytes (NULL_PTR to discard them)
+ *                      uint16 len
+ *                         number of bytes
+ *  [Returns] :			NONE
+ *  [Remarks] :         Waits for an asynchronous transfer in progress to complete first
+ ***************************************************************************************************/
+
+void SPI_transfer(const uint8 * tx_Ptr,uint8 * rx_Ptr,uint16 len)
+{
+	uint8 next;
+
+	if(len == 0)
+		return;
+
+	while(g_spiBusy){}	/* an asynchronous transfer owns the bus */
+
+	len--;	/* the first byte is started before the loops */
+
+	if(tx_Ptr == NULL_PTR)
+	{
+		/* Receive only */
+		SPDR = SPI_DUMMY_BYTE;
+		while(len >= 2)
+		{
+			SPI_RX_STEP();
+			SPI_RX_STEP();
+			len -= 2;
+		}
+		if(len)
+		{
+			SPI_RX_STEP();
+		}
+	}
+	else if(rx_Ptr == NULL_PTR)
+	{
+		/* Send only */
+		SPDR = *tx_Ptr++;
+		while(len >= 2)
+		{
+			SPI_TX_STEP();
+			SPI_TX_STEP();
+			len -= 2;
+		}
+		if(len)
+		{
+			SPI_TX_STEP();
+		}
+	}
+	else
+	{
+		/* Full duplex */
+		SPDR = *tx_Ptr++;
+		while(len >= 2)
+		{
+			SPI_FULL_STEP();
+			SPI_FULL_STEP();
+			len -= 2;
+		}
+		if(len)
+		{
+			SPI_FULL_STEP();
+		}
+	}
+
+	/* Last byte, reading SPDR also clears SPIF */
+	while(BIT_IS_CLEAR(SPSR,SPIF)){}
+	next = SPDR;
+	if(rx_Ptr != NULL_PTR)
+	{
+		*rx_Ptr = next;
+	}
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    SPI_transferAsync
+ *  [Description] :		This Function starts sending and receiving a block of bytes in the background,
+ *                      the SPI transfer complete interrupt sends the next bytes and the call back
+ *                      function is called from the interrupt after the last byte
+ *  [Args] :            const uint8 * tx_Ptr
+ *                         bytes to send (NULL_PTR to send SPI_DUMMY_BYTE)
+ *                      uint8 * rx_Ptr
+ *                         buffer of the received bytes (NULL_PTR to discard them)
+ *                      uint16 len
+ *                         number of bytes
+ *                      void(*a_ptr)(void)
+ *                         call back function (NULL_PTR if not needed)
+ *  [Returns] :			uint8
+ *                         ERROR in case of another transfer in progress or zero length
+ *                         SUCCESS otherwise
+ *  [Remarks] :         The buffers must stay valid until the transfer completes (SPI_isBusy)
+ ***************************************************************************************************/
+
+uint8 SPI_transferAsync(const uint8 * tx_Ptr,uint8 * rx_Ptr,uint16 len,void(*a_ptr)(void))
+{
+	uint8 status = ERROR;
+
+	if(len == 0)
+		return ERROR;
+
+	ATOMIC_BEGIN();
+	if(!g_spiBusy)
+	{
+		g_spiBusy = TRUE;
+		g_spiRx = rx_Ptr;
+		g_spiCount = len - 1;
+		g_spiCallBack = a_ptr;
+
+		(void)SPSR;		/* with the SPDR write below it clears an old SPIF */
+		if(tx_Ptr == NULL_PTR)
+		{
+			SPDR = SPI_DUMMY_BYTE;
+		}
+		else
+		{
+			SPDR = *tx_Ptr++;
+		}
+		g_spiTx = tx_Ptr;
+		SET_BIT(SPCR,SPIE);
+		status = SUCCESS;
+	}
+	ATOMIC_END();
+
+	return status;
+}
+
+#else
+/*************************************************************************************************
+ *  [Function Name]:    SPI_initSlave
+ *  [Description] :		This Function initializes the SPI as slave
+ *                      1-Set MISO as output and MOSI , SCK and SS as inputs
+ *                      2-Set required mode (clock polarity and phase) and data order
+ *                      3-Enable the SPI interrupt and the rising edge interrupt of the SS pin
+ *  [Args] :            Pointer to Struct SPI_ConfigType
+ *                         the clock is given by the master (s_clock is not used)
+ *  [Returns] :			NONE
+ *  [Remarks] :         SPI_DUMMY_BYTE is sent until a response is staged with SPI_slaveSetResponse
+ ***************************************************************************************************/
+
+void SPI_initSlave(const SPI_ConfigType * config_Ptr)
+{
+	SPI_PORT_DIR = (SPI_PORT_DIR & ~((1<<SPI_SS) | (1<<SPI_MOSI) | (1<<SPI_SCK))) | (1<<SPI_MISO);
+
+	g_slaveTxLength[0] = 0;
+	g_slaveTxLength[1] = 0;
+	g_slaveTxActive = 0;
+	g_slaveTxStaged = FALSE;
+	g_slaveRxActive = 0;
+	g_slaveFrameCount = 0;
+	g_slaveFrameRead = 0;
+	g_slaveIndex = 0;
+
+	/************************** SPCR Description **************************
+	 * SPIE    = 1 every received byte is handled by the SPI ISR
+	 * SPE     = 1 SPI enable
+	 * DORD    = required data order
+	 * MSTR    = 0 slave
+	 * CPOL    = bit 1 of the mode , CPHA = bit 0 of the mode
+	 ***********************************************************************/
+	SPCR = (1<<SPIE) | (1<<SPE) | ((config_Ptr->s_dataOrder)<<DORD) | ((config_Ptr->s_mode)<<CPHA);
+	SPDR = SPI_DUMMY_BYTE;
+
+	/* Rising edge of SS ends the frame */
+#if (SPI_SS_INT == 0)
+	MCUCR |= (1<<ISC01) | (1<<ISC00);
+#elif (SPI_SS_INT == 1)
+	MCUCR |= (1<<ISC11) | (1<<ISC10);
+#else
+	SET_BIT(MCUCSR,ISC2);
+#endif
+	GIFR = (1<<SPI_SS_INT_FLAG);
+	SET_BIT(GICR,SPI_SS_INT_ENABLE);
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    SPI_slaveSetResponse
+ *  [Description] :		This Function stages the response of the next frame , it is swapped in at the
+ *                      end of the current frame (SS rising edge) and repeated until another
+ *                      response is staged
+ *  [Args] :            const uint8 * data_Ptr
+ *                         response bytes (SPI_DUMMY_BYTE is sent after them)
+ *                      uint8 len
+ *                         number of bytes (up to SPI_SLAVE_BUFFER_SIZE)
+ *  [Returns] :			uint8
+ *                         ERROR in case the previous staged response is not swapped in yet or
+ *                         invalid length
+ *                         SUCCESS otherwise
+ ***************************************************************************************************/
+
+uint8 SPI_slaveSetResponse(const uint8 * data_Ptr,uint8 len)
+{
+	uint8 i;
+	uint8 staging;
+
+	if((len > SPI_SLAVE_BUFFER_SIZE) || g_slaveTxStaged)
+		return ERROR;
+
+	/* The ISR's do not use the staging buffer until g_slaveTxStaged is set */
+	staging = g_slaveTxActive ^ 1;
+	for(i=0;i<len;i++)
+	{
+		g_slaveTxBuffer[staging][i] = data_Ptr[i];
+	}
+	g_slaveTxLength[staging] = len;
+	g_slaveTxStaged = TRUE;
+
+	return SUCCESS;
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    SPI_slaveGetFrame
+ *  [Description] :		This Function copies the last frame received from the master
+ *  [Args] :            uint8 * buff_Ptr
+ *                         buffer of SPI_SLAVE_BUFFER_SIZE bytes
+ *  [Returns] :			uint8
+ *                         number of bytes of the frame , 0 in case no new frame is received
+ *  [Remarks] :         The interrupts are not disabled during the copy (the slave ISR must never be
+ *                      delayed) , the copy is repeated if a new frame ended meanwhile
+ ***************************************************************************************************/
+
+uint8 SPI_slaveGetFrame(uint8 * buff_Ptr)
+{
+	uint8 i;
+	uint8 count;
+	uint8 len;
+	const uint8 * frame_Ptr;
+
+	do
+	{
+		count = g_slaveFrameCount;
+		if(count == g_slaveFrameRead)
+			return 0;
+
+		frame_Ptr = g_slaveRxBuffer[g_slaveRxActive ^ 1];
+		len = g_slaveFrameLength;
+		for(i=0;i<len;i++)
+		{
+			buff_Ptr[i] = frame_Ptr[i];
+		}
+	}while(count != g_slaveFrameCount);	/* the buffer was reused by a newer frame */
+
+	g_slaveFrameRead = count;
+	return len;
+}
+#endif
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+
+#ifndef SPI_SLAVE
+ISR(SPI_STC_vect)
+{
+	uint8 received;
+	uint8 * rx_Ptr = g_spiRx;
+	uint16 count = g_spiCount;
+
+	/* Start the next byte first, the received byte stays in the receive buffer */
+	if(count != 0)
+	{
+		const uint8 * tx_Ptr = g_spiTx;
+
+		if(tx_Ptr == NULL_PTR)
+		{
+			SPDR = SPI_DUMMY_BYTE;
+		}
+		else
+		{
+			SPDR = *tx_Ptr++;
+			g_spiTx = tx_Ptr;
+		}
+		g_spiCount = count - 1;
+	}
+
+	received = SPDR;
+	if(rx_Ptr != NULL_PTR)
+	{
+		*rx_Ptr++ = received;
+		g_spiRx = rx_Ptr;
+	}
+
+	if(count == 0)
+	{
+		void (*callBack)(void) = g_spiCallBack;
+
+		CLEAR_BIT(SPCR,SPIE);
+		g_spiBusy = FALSE;
+		if(callBack != NULL_PTR)
+		{
+			(*callBack)();
+		}
+	}
+}
+#else
+ISR(SPI_STC_vect)
+{
+	uint8 index = g_slaveIndex;
+	uint8 tx = g_slaveTxActive;
+	uint8 next = index + 1;
+
+	/* Load the next response byte first , the master may clock it right away */
+	SPDR = (next < g_slaveTxLength[tx]) ? g_slaveTxBuffer[tx][next] : SPI_DUMMY_BYTE;
+
+	if(index < SPI_SLAVE_BUFFER_SIZE)
+	{
+		g_slaveRxBuffer[g_slaveRxActive][index] = SPDR;
+		g_slaveIndex = next;
+	}
+}
+
+ISR(SPI_SS_INT_VECT)
+{
+	uint8 tx;
+
+	/* The completed frame becomes readable and the other receive buffer takes the next frame */
+	g_slaveFrameLength = g_slaveIndex;
+	g_slaveRxActive ^= 1;
+	g_slaveFrameCount++;
+	g_slaveIndex = 0;
+
+	if(g_slaveTxStaged)
+	{
+		g_slaveTxActive ^= 1;
+		g_slaveTxStaged = FALSE;
+	}
+
+	/* First byte of the next frame (SS is high so SPDR can be written) */
+	tx = g_slaveTxActive;
+	SPDR = (g_slaveTxLength[tx] != 0) ? g_slaveTxBuffer[tx][0] : SPI_DUMMY_BYTE;
+}
+#endif
@@ -0,0 +1,94 @@
+/******************************************************************************
+ *
+ * Module: SPI
+ *
+ * File Name: spi.h
+ *
+ * Description: header file for the SPI AVR driver
+ *
+ * Author: Ganna Ahmed
+ *
+ *******************************************************************************/
+
+#ifndef SPI_H_
+#define SPI_H_
+
+#include "std_types.h"
+#include "common_macros.h"
+#include "micro_configurations.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* SPI HW Pins */
+#define SPI_PORT_OUT PORTB
+#define SPI_PORT_DIR DDRB
+#define SPI_SS   PB4
+#define SPI_MOSI PB5
+#define SPI_MISO PB6
+#define SPI_SCK  PB7
+
+/* Byte sent while only receiving */
+#define SPI_DUMMY_BYTE 0xFF
+
+/* Slave mode: the SPI interrupt answers the master from a response buffer staged in advance,
+ * SS is also wired to the external interrupt pin SPI_SS_INT whose rising edge (end of the frame)
+ * swaps the response and the receive buffers (the master functions are not available) */
+#define SPI_SLAVE
+#undef SPI_SLAVE  /* Remove This line in case you want to use the slave mode */
+
+/* the external interrupt SPI_SS_INT is chosen in micro_configurations.h */
+#define SPI_SLAVE_BUFFER_SIZE 32     /* maximum frame length (up to 255) */
+
+#define ERROR 0
+#define SUCCESS 1
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+/* Mode n is CPOL = n>>1 , CPHA = n&1 */
+typedef enum
+{
+	SPI_MODE_0,SPI_MODE_1,SPI_MODE_2,SPI_MODE_3
+}SPI_ModeType;
+
+/* Bits 1:0 are SPR1:0 and bit 2 is SPI2X (double speed) */
+typedef enum
+{
+	SPI_F_CPU_4,SPI_F_CPU_16,SPI_F_CPU_64,SPI_F_CPU_128,
+	SPI_F_CPU_2,SPI_F_CPU_8,SPI_F_CPU_32,SPI_F_CPU_64_2X
+}SPI_ClockType;
+
+typedef enum
+{
+	SPI_MSB_FIRST,SPI_LSB_FIRST
+}SPI_DataOrderType;
+
+typedef struct
+{
+	SPI_ModeType s_mode;
+	SPI_ClockType s_clock;
+	SPI_DataOrderType s_dataOrder;
+}SPI_ConfigType;
+
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+uint8 SPI_isBusy(void);
+
+#ifndef SPI_SLAVE
+void SPI_initMaster(const SPI_ConfigType * config_Ptr);
+uint8 SPI_sendReceiveByte(const uint8 data);
+void SPI_transfer(const uint8 * tx_Ptr,uint8 * rx_Ptr,uint16 len);
+uint8 SPI_transferAsync(const uint8 * tx_Ptr,uint8 * rx_Ptr,uint16 len,void(*a_ptr)(void));
+#else
+void SPI_initSlave(const SPI_ConfigType * config_Ptr);
+uint8 SPI_slaveSetResponse(const uint8 * data_Ptr,uint8 len);
+uint8 SPI_slaveGetFrame(uint8 * buff_Ptr);
+#endif
+
+#endif /* SPI_H_ */
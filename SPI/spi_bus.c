@@ -0,0 +1,282 @@
+/******************************************************************************
+ *
+ * Module: SPI
+ *
+ * File Name: spi_bus.c
+ *
+ * Description: Source file for the SPI bus manager (several devices sharing the SPI master)
+ *
+ * Author: Ganna Ahmed
+ *
+ *******************************************************************************/
+
+#include "spi_bus.h"
+#include "ring_buffer.h"
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Pending transactions , the oldest one is on the bus while the queue is not empty */
+/* Queued transactions from SPI_busSubmit (producer) to the SPI ISR (consumer) , the oldest one
+ * is the transaction on the bus and stays in the queue until it completes */
+RING_BUFFER_DEFINE(busQueue,SPI_TransactionType *,SPI_BUS_QUEUE_SIZE)
+static busQueue_RingType g_busQueue;
+
+/*******************************************************************************
+ *                      Private Functions Prototypes                           *
+ *******************************************************************************/
+
+static SPI_TransactionType * SPI_busCurrent(void);
+static void SPI_busStart(void);
+static void SPI_busHeaderDone(void);
+static void SPI_busTransactionDone(void);
+static void SPI_busComplete(uint8 status);
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Transaction on the bus (the oldest queued one , the queue must not be empty) */
+static SPI_TransactionType * SPI_busCurrent(void)
+{
+	uint8 count;
+
+	return *busQueue_peek(&g_busQueue,&count);
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    SPI_busStart
+ *  [Description] :		This Function starts the oldest queued transaction
+ *                      1-Write the control registers only if they differ from the device settings
+ *                      2-Select the device (chip select low)
+ *                      3-Start the asynchronous transfer of the header (or the data if no header)
+ *  [Args] :            NONE
+ *  [Returns] :			NONE
+ *  [Remarks] :         Called with the interrupts disabled or from the SPI ISR
+ *                      The registers themselves are compared (not a copy of the last written values)
+ *                      so a SPI_initMaster call outside the bus is seen , reading them costs less
+ *                      than reading a global copy
+ *                      In case the asynchronous transfer can't start (a transfer started outside the
+ *                      bus) the transaction completes with ERROR
+ ***************************************************************************************************/
+
+static void SPI_busStart(void)
+{
+	SPI_TransactionType * transaction_Ptr = SPI_busCurrent();
+	SPI_DeviceType * device_Ptr = transaction_Ptr->s_device;
+	uint8 started;
+
+	/* Mode is changed before the chip select so the clock idle level is settled
+	 * (SPIE is clear between transfers , only SPI2X is writable in SPSR) */
+	if(SPCR != device_Ptr->s_spcr)
+	{
+		SPCR = device_Ptr->s_spcr;
+	}
+	if((SPSR & (1<<SPI2X)) != device_Ptr->s_spsr)
+	{
+		SPSR = device_Ptr->s_spsr;
+	}
+
+	CLEAR_BIT(*(device_Ptr->s_csPort),device_Ptr->s_csPin);
+	if(transaction_Ptr->s_headerLen != 0)
+	{
+		started = SPI_transferAsync(transaction_Ptr->s_header,NULL_PTR,transaction_Ptr->s_headerLen,SPI_busHeaderDone);
+	}
+	else
+	{
+		started = SPI_transferAsync(transaction_Ptr->s_tx,transaction_Ptr->s_rx,transaction_Ptr->s_len,SPI_busTransactionDone);
+	}
+
+	if(started == ERROR)
+	{
+		SPI_busComplete(ERROR);
+	}
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    SPI_busHeaderDone
+ *  [Description] :		This Function is the call back of the header transfer, it starts the data
+ *                      transfer with the device still selected
+ *  [Args] :            NONE
+ *  [Returns] :			NONE
+ ***************************************************************************************************/
+
+static void SPI_busHeaderDone(void)
+{
+	SPI_TransactionType * transaction_Ptr = SPI_busCurrent();
+
+	if(transaction_Ptr->s_len == 0)
+	{
+		SPI_busComplete(SUCCESS);
+	}
+	else if(SPI_transferAsync(transaction_Ptr->s_tx,transaction_Ptr->s_rx,transaction_Ptr->s_len,SPI_busTransactionDone) == ERROR)
+	{
+		SPI_busComplete(ERROR);
+	}
+}
+
+/* Call back of the data transfer */
+static void SPI_busTransactionDone(void)
+{
+	SPI_busComplete(SUCCESS);
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    SPI_busComplete
+ *  [Description] :		This Function deselects the device , completes the oldest transaction and
+ *                      starts the next queued one
+ *  [Args] :            uint8 status
+ *                         SUCCESS , or ERROR if the transfer couldn't start
+ *  [Returns] :			NONE
+ *  [Remarks] :         The next transaction is started before the call back , so a transaction
+ *                      submitted by the call back is only queued (and the SPI driver is free
+ *                      when the next one starts)
+ ***************************************************************************************************/
+
+static void SPI_busComplete(uint8 status)
+{
+	SPI_TransactionType * transaction_Ptr = SPI_busCurrent();
+	void (*callBack)(void) = transaction_Ptr->s_callBack;
+
+	SET_BIT(*(transaction_Ptr->s_device->s_csPort),transaction_Ptr->s_device->s_csPin);
+
+	busQueue_release(&g_busQueue,1);
+
+	/* The transaction may be released once s_done is set */
+	transaction_Ptr->s_status = status;
+	transaction_Ptr->s_done = TRUE;
+
+	if(busQueue_count(&g_busQueue) != 0)
+	{
+		SPI_busStart();
+	}
+
+	if(callBack != NULL_PTR)
+	{
+		(*callBack)();
+	}
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*************************************************************************************************
+ *  [Function Name]:    SPI_deviceInit
+ *  [Description] :		This Function initializes the handle of a device on the bus
+ *                      1-Set the chip select pin as output high (not selected)
+ *                      2-Compute the control registers values of the device mode , data order and clock
+ *  [Args] :            SPI_DeviceType * device_Ptr
+ *                         handle of the device (must stay valid while the device is used)
+ *                      volatile uint8 * cs_port
+ *                         PORTx of the chip select pin (for example &PORTB)
+ *                      volatile uint8 * cs_port_dir
+ *                         DDRx of the chip select pin (for example &DDRB)
+ *                      uint8 cs_pin
+ *                      Pointer to Struct SPI_ConfigType
+ *  [Returns] :			NONE
+ *  [Remarks] :         SPI_initMaster must be called once before using the bus (pins setup)
+ ***************************************************************************************************/
+
+void SPI_deviceInit(SPI_DeviceType * device_Ptr,volatile uint8 * cs_port,volatile uint8 * cs_port_dir,uint8 cs_pin,const SPI_ConfigType * config_Ptr)
+{
+	device_Ptr->s_csPort = cs_port;
+	device_Ptr->s_csPortDir = cs_port_dir;
+	device_Ptr->s_csPin = cs_pin;
+
+	SET_BIT(*cs_port,cs_pin);
+	SET_BIT(*cs_port_dir,cs_pin);
+
+	/* Same values as SPI_initMaster (SPIE is set by the asynchronous transfer) */
+	device_Ptr->s_spcr = (1<<SPE) | (1<<MSTR) | ((config_Ptr->s_dataOrder)<<DORD) | ((config_Ptr->s_mode)<<CPHA) | ((config_Ptr->s_clock) & 0x03);
+	device_Ptr->s_spsr = ((config_Ptr->s_clock)>>2)<<SPI2X;
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    SPI_busSubmit
+ *  [Description] :		This Function queues a transaction , it starts at once if the bus is free
+ *                      otherwise after the queued transactions (safe to call from ISR's and the main loop)
+ *  [Args] :            SPI_TransactionType * transaction_Ptr
+ *                         transaction (must stay valid until s_done is TRUE)
+ *  [Returns] :			uint8
+ *                         ERROR in case the queue is full , nothing to send or the bus is free but
+ *                         the SPI driver is busy with a transfer started outside the bus
+ *                         SUCCESS otherwise
+ ***************************************************************************************************/
+
+uint8 SPI_busSubmit(SPI_TransactionType * transaction_Ptr)
+{
+	uint8 idle;
+	uint8 status = ERROR;
+
+	if((transaction_Ptr->s_len == 0) && (transaction_Ptr->s_headerLen == 0))
+		return ERROR;
+
+	transaction_Ptr->s_done = FALSE;
+
+	/* The ISR completes transactions meanwhile , the check and the push must not be separated */
+	ATOMIC_BEGIN();
+	idle = (busQueue_count(&g_busQueue) == 0) ? TRUE : FALSE;
+	if(!(idle && SPI_isBusy()) && (busQueue_push(&g_busQueue,&transaction_Ptr) == SUCCESS))
+	{
+		/* Bus was free */
+		if(idle)
+		{
+			SPI_busStart();
+		}
+		status = SUCCESS;
+	}
+	ATOMIC_END();
+
+	return status;
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    SPI_busFree
+ *  [Description] :		This Function returns the number of transactions which can be queued
+ *  [Args] :            NONE
+ *  [Returns] :			uint8
+ *                         free entries of the queue
+ *  [Remarks] :         The ISR only frees entries , to queue several transactions together check
+ *                      and submit them in an atomic section (other submitters may be ISR's)
+ ***************************************************************************************************/
+
+uint8 SPI_busFree(void)
+{
+	return busQueue_free(&g_busQueue);
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    SPI_busTransfer
+ *  [Description] :		This Function queues a transaction and waits until it is done
+ *  [Args] :            SPI_DeviceType * device_Ptr
+ *                      const uint8 * tx_Ptr
+ *                         bytes to send (NULL_PTR to send SPI_DUMMY_BYTE)
+ *                      uint8 * rx_Ptr
+ *                         buffer of the received bytes (NULL_PTR to discard them)
+ *                      uint16 len
+ *  [Returns] :			uint8
+ *                         ERROR in case the transaction couldn't be queued or started (see SPI_busSubmit)
+ *                         SUCCESS otherwise
+ *  [Remarks] :         Must not be called from an ISR (the interrupts must be enabled)
+ ***************************************************************************************************/
+
+uint8 SPI_busTransfer(SPI_DeviceType * device_Ptr,const uint8 * tx_Ptr,uint8 * rx_Ptr,uint16 len)
+{
+	SPI_TransactionType transaction;
+
+	transaction.s_device = device_Ptr;
+	transaction.s_headerLen = 0;
+	transaction.s_tx = tx_Ptr;
+	transaction.s_rx = rx_Ptr;
+	transaction.s_len = len;
+	transaction.s_callBack = NULL_PTR;
+
+	if(SPI_busSubmit(&transaction) == ERROR)
+		return ERROR;
+
+	while(!transaction.s_done){}
+
+	return transaction.s_status;
+}
@@ -0,0 +1,64 @@
+/******************************************************************************
+ *
+ * Module: SPI
+ *
+ * File Name: spi_bus.h
+ *
+ * Description: header file for the SPI bus manager (several devices sharing the SPI master)
+ *
+ * Author: Ganna Ahmed
+ *
+ *******************************************************************************/
+
+#ifndef SPI_BUS_H_
+#define SPI_BUS_H_
+
+#include "spi.h"
+
+#ifdef SPI_SLAVE
+#error "SPI bus manager needs the SPI master mode"
+#endif
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+#define SPI_BUS_QUEUE_SIZE 8    /* number of queued transactions (power of 2 , maximum 128) */
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct
+{
+	volatile uint8 * s_csPort;      /* PORTx of the chip select pin */
+	volatile uint8 * s_csPortDir;   /* DDRx of the chip select pin */
+	uint8 s_csPin;
+	uint8 s_spcr;                   /* control registers of the device (set by SPI_deviceInit) */
+	uint8 s_spsr;
+}SPI_DeviceType;
+
+typedef struct
+{
+	SPI_DeviceType * s_device;
+	const uint8 * s_header;         /* command bytes sent first in the same selection (received bytes discarded) */
+	uint8 s_headerLen;              /* 0 if no command bytes */
+	const uint8 * s_tx;             /* bytes to send (NULL_PTR to send SPI_DUMMY_BYTE) */
+	uint8 * s_rx;                   /* received bytes (NULL_PTR to discard them) */
+	uint16 s_len;                   /* 0 for a command without data */
+	void (*s_callBack)(void);       /* called from the SPI ISR after the transaction (or NULL_PTR) */
+	volatile uint8 s_status;        /* SUCCESS , or ERROR if the transfer couldn't start (valid once s_done) */
+	volatile uint8 s_done;          /* set to TRUE after the transaction */
+}SPI_TransactionType;
+
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+void SPI_deviceInit(SPI_DeviceType * device_Ptr,volatile uint8 * cs_port,volatile uint8 * cs_port_dir,uint8 cs_pin,const SPI_ConfigType * config_Ptr);
+uint8 SPI_busSubmit(SPI_TransactionType * transaction_Ptr);
+uint8 SPI_busFree(void);
+uint8 SPI_busTransfer(SPI_DeviceType * device_Ptr,const uint8 * tx_Ptr,uint8 * rx_Ptr,uint16 len);
+
+#endif /* SPI_BUS_H_ */
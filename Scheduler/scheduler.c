@@ -0,0 +1,270 @@
+/******************************************************************************
+ *
+ * Module: Scheduler
+ *
+ * File Name: scheduler.c
+ *
+ * Description: Source file for the cooperative (run to completion) task scheduler
+ *
+ * Author: Ganna Ahmed
+ *
+ *******************************************************************************/
+
+#include "scheduler.h"
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct
+{
+	void (*s_task)(void);
+	uint16 s_period;
+	volatile uint16 s_delay;       /* Ticks remaining until the next release */
+	volatile uint8 s_overruns;     /* Releases missed because the task was still pending or running */
+}SCH_TaskType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Task table indexed by priority */
+static SCH_TaskType g_tasks[SCH_MAX_TASKS];
+
+/* Bit n is set when the task of priority n is released and waiting to run */
+static volatile uint8 g_readyTasks = 0;
+
+/* Bit n is set while the task of priority n is running */
+static volatile uint8 g_runningTasks = 0;
+
+static volatile uint32 g_ticks = 0;
+
+/* Index of the most significant set bit of a 4-bit value (used for O(1) highest priority lookup) */
+static const uint8 g_highestBit[16] = {0,0,1,1,2,2,2,2,3,3,3,3,3,3,3,3};
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*************************************************************************************************
+ *  [Function Name]:    SCH_tick
+ *  [Description] :		This Function is the timer call back, it counts down every task delay and
+ *                      sets the ready bit of the tasks which are due
+ *  [Args] :            NONE
+ *  [Returns] :			NONE
+ *  [Remarks] :         In case of compile time binding of the timer call backs (TIMER_STATIC_CALLBACK)
+ *                      call it from the hook of the tick timer interrupt in "timers_hooks.h"
+ ***************************************************************************************************/
+
+void SCH_tick(void)
+{
+	uint8 priority;
+	uint8 mask = 0x01;
+
+	g_ticks++;
+
+	for(priority=0;priority<SCH_MAX_TASKS;priority++,mask<<=1)
+	{
+		/* Empty slot or one shot task which is already released and waiting to run */
+		if((g_tasks[priority].s_task == NULL_PTR) ||
+		   ((g_tasks[priority].s_period == 0) && (g_readyTasks & mask)))
+		{
+			continue;
+		}
+
+		if(g_tasks[priority].s_delay > 0)
+		{
+			g_tasks[priority].s_delay--;
+		}
+
+		if(g_tasks[priority].s_delay == 0)
+		{
+			/* Previous release is not completed yet, the task missed its deadline */
+			if(((g_readyTasks | g_runningTasks) & mask) && (g_tasks[priority].s_overruns < 0xFF))
+			{
+				g_tasks[priority].s_overruns++;
+			}
+
+			g_readyTasks |= mask;
+
+			/* Reload the delay for periodic tasks, one shot tasks keep delay 0 until they run */
+			g_tasks[priority].s_delay = g_tasks[priority].s_period;
+		}
+	}
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    SCH_init
+ *  [Description] :		This Function initializes the scheduler
+ *                      1-Clear the task table
+ *                      2-Initialize the required timer to generate the scheduler tick
+ *                      3-Set the scheduler tick as the timer call back function (run time binding only)
+ *  [Args] :            Pointer to Struct timer_ConfigType
+ *                         Timer configuration (the tick period is the timer interrupt period)
+ *  [Returns] :			NONE
+ ***************************************************************************************************/
+
+void SCH_init(const timer_ConfigType * config_Ptr)
+{
+	uint8 priority;
+
+	for(priority=0;priority<SCH_MAX_TASKS;priority++)
+	{
+		g_tasks[priority].s_task = NULL_PTR;
+	}
+	g_readyTasks = 0;
+	g_runningTasks = 0;
+	g_ticks = 0;
+
+#ifndef TIMER_STATIC_CALLBACK
+	if(config_Ptr->s_timerType==0){
+		timer0_setCallBack(SCH_tick);
+	}
+	else if(config_Ptr->s_timerType==1){
+		timer1_setCallBack(SCH_tick);
+	}
+	else if(config_Ptr->s_timerType==2){
+		timer2_setCallBack(SCH_tick);
+	}
+#endif
+
+	timer_init(config_Ptr);
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    SCH_addTask
+ *  [Description] :		This Function adds a task to the task table, the task is released first
+ *                      after s_offset ticks then every s_period ticks
+ *  [Args] :            Pointer to Struct SCH_TaskConfigType
+ *  [Returns] :			uint8
+ *                         ERROR in case of invalid priority or the priority is already used
+ *                         SUCCESS otherwise
+ ***************************************************************************************************/
+
+uint8 SCH_addTask(const SCH_TaskConfigType * task_Ptr)
+{
+	uint8 priority = task_Ptr->s_priority;
+
+	if((priority >= SCH_MAX_TASKS) || (task_Ptr->s_task == NULL_PTR))
+		return ERROR;
+
+	if(g_tasks[priority].s_task != NULL_PTR)
+		return ERROR;
+
+	/* The tick interrupt must not see a half written task */
+	ATOMIC_BEGIN();
+	g_tasks[priority].s_period = task_Ptr->s_period;
+	g_tasks[priority].s_delay = task_Ptr->s_offset;
+	g_tasks[priority].s_overruns = 0;
+	g_tasks[priority].s_task = task_Ptr->s_task;
+	ATOMIC_END();
+
+	return SUCCESS;
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    SCH_deleteTask
+ *  [Description] :		This Function removes a task from the task table and cancels its pending release
+ *  [Args] :            uint8 priority
+ *                         priority of the task (0 to SCH_MAX_TASKS-1)
+ *  [Returns] :			NONE
+ ***************************************************************************************************/
+
+void SCH_deleteTask(uint8 priority)
+{
+	if(priority >= SCH_MAX_TASKS)
+		return;
+
+	ATOMIC_BEGIN();
+	g_tasks[priority].s_task = NULL_PTR;
+	CLEAR_BIT(g_readyTasks,priority);
+	ATOMIC_END();
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    SCH_dispatchTasks
+ *  [Description] :		This Function runs the highest priority ready task to completion
+ *                      (lookup of the highest priority is done in constant time using the ready bitmap)
+ *                      One shot tasks are removed from the table after they run
+ *  [Args] :            NONE
+ *  [Returns] :			NONE
+ *  [Remarks] :         Call it in the super loop, every call runs at most one task so higher
+ *                      priority tasks released meanwhile are picked first in the next call
+ ***************************************************************************************************/
+
+void SCH_dispatchTasks(void)
+{
+	uint8 ready;
+	uint8 priority = 0;
+	void (*task)(void) = NULL_PTR;
+
+	ATOMIC_BEGIN();
+	ready = g_readyTasks;
+	if(ready != 0)
+	{
+		/* Highest set bit of the ready bitmap is the highest priority ready task */
+		if(ready & 0xF0)
+		{
+			priority = 4 + g_highestBit[ready>>4];
+		}
+		else
+		{
+			priority = g_highestBit[ready];
+		}
+
+		CLEAR_BIT(g_readyTasks,priority);
+		SET_BIT(g_runningTasks,priority);
+		task = g_tasks[priority].s_task;
+
+		/* One shot task, free its slot */
+		if(g_tasks[priority].s_period == 0)
+		{
+			g_tasks[priority].s_task = NULL_PTR;
+		}
+	}
+	ATOMIC_END();
+
+	if(ready == 0)
+		return;
+
+	if(task != NULL_PTR)
+	{
+		(*task)();
+	}
+
+	ATOMIC_BEGIN();
+	CLEAR_BIT(g_runningTasks,priority);
+	ATOMIC_END();
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    SCH_getOverrunCount
+ *  [Description] :		This Function returns how many times a task was released while its previous
+ *                      release was still waiting or running (saturates at 255)
+ *  [Args] :            uint8 priority
+ *                         priority of the task (0 to SCH_MAX_TASKS-1)
+ *  [Returns] :			uint8
+ *                         number of overruns of the task
+ ***************************************************************************************************/
+
+uint8 SCH_getOverrunCount(uint8 priority)
+{
+	if(priority >= SCH_MAX_TASKS)
+		return 0;
+
+	return g_tasks[priority].s_overruns;
+}
+
+/*************************************************************************************************
+ *  [Function Name]:    SCH_getTicks
+ *  [Description] :		This Function returns the number of scheduler ticks since SCH_init
+ *  [Args] :            NONE
+ *  [Returns] :			uint32
+ *                         number of ticks
+ ***************************************************************************************************/
+
+uint32 SCH_getTicks(void)
+{
+	/* 32-bit value is read in several instructions so the tick interrupt is blocked meanwhile */
+	return ATOMIC_READ32(g_ticks);
+}
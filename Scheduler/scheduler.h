@@ -0,0 +1,70 @@
+/******************************************************************************
+ *
+ * Module: Scheduler
+ *
+ * File Name: scheduler.h
+ *
+ * Description: header file for the cooperative (run to completion) task scheduler
+ *
+ * Author: Ganna Ahmed
+ *
+ *******************************************************************************/
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+#include "std_types.h"
+#include "common_macros.h"
+#include "micro_configurations.h"
+#include "timers.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Maximum number of tasks, every task owns one priority level (0 lowest , 7 highest)
+ * so the ready tasks fit in one byte bitmap */
+#define SCH_MAX_TASKS 8
+
+#define ERROR 0
+#define SUCCESS 1
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct
+{
+	void (*s_task)(void);  /* Task function (must return, it is run to completion) */
+	uint16 s_period;       /* Period in ticks, 0 for a one shot task */
+	uint16 s_offset;       /* Ticks before the first release of the task */
+	uint8 s_priority;      /* Priority level from 0 to SCH_MAX_TASKS-1 (higher runs first) */
+}SCH_TaskConfigType;
+
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/* Function initializes the scheduler tick on the required timer and clears the task table */
+void SCH_init(const timer_ConfigType * config_Ptr);
+
+/* Function adds a task to the task table in the slot of its priority */
+uint8 SCH_addTask(const SCH_TaskConfigType * task_Ptr);
+
+/* Function removes the task of a certain priority from the task table */
+void SCH_deleteTask(uint8 priority);
+
+/* Function counts down the task delays and releases the due tasks, called every timer interrupt */
+void SCH_tick(void);
+
+/* Function runs the highest priority ready task, called repeatedly from the main loop */
+void SCH_dispatchTasks(void);
+
+/* Function returns number of releases of a task that happened before its previous release was completed */
+uint8 SCH_getOverrunCount(uint8 priority);
+
+/* Function returns the number of scheduler ticks since SCH_init */
+uint32 SCH_getTicks(void);
+
+#endif /* SCHEDULER_H_ */
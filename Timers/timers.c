@@ -12,77 +12,380 @@
 
 #include "timers.h"
 
+#ifdef TIMER_INSTRUMENTATION
+#include "UART.h"
+#endif
+
 /*******************************************************************************
  *                           Global Variables                                  *
  *******************************************************************************/
 
-/* Global variables to hold the address of the call back function in the application */
+/* Bit 0 for channel A , bit 1 for channel B : set when the compare interrupt of
+ * the channel is scheduled once by timer1_scheduleEvent */
+static volatile uint8 g_timer1OneShot = 0;
+
+#ifdef TIMER_INSTRUMENTATION
+/* ISR statistics indexed by timer_statsVector */
+static timer_StatsType g_timerStats[TIMER_STATS_VECTORS];
+
+/* Names used by timer_dumpStats */
+static const char * const g_timerStatsNames[TIMER_STATS_VECTORS] =
+{
+	"T0_OVF","T0_COMP","T1_OVF","T1_COMPA","T1_COMPB","T2_OVF","T2_COMP"
+};
+#endif
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Timer1 counts up to OCR1A in compare (CTC) mode and up to 0xFFFF in normal mode */
+#define TIMER1_TOP (BIT_IS_SET(TCCR1B,WGM12) ? OCR1A : 0xFFFF)
+
+/* Sets a TIMSK enable bit only if the vector has an ISR (TIMER_HOOKED_INTERRUPTS) ,
+ * the interrupt of a vector without ISR would jump to the reset vector */
+#define TIMER_ENABLE_INTERRUPT(bit) \
+	do{ if(TIMER_HOOKED_INTERRUPTS & (1<<(bit))) { SET_BIT(TIMSK,bit); } }while(0)
+
+#ifdef TIMER_INSTRUMENTATION
+/* Samples the counter on ISR entry and computes the latency from the counter value
+ * at which the interrupt flag was set (match) , top is the last counter value before it wraps */
+#define TIMER_STATS_ENTRY(counter,match,top) \
+	uint16 statsEntry = (counter); \
+	uint16 statsTop = (top); \
+	uint16 statsLatency = timer_elapsed((match),statsEntry,statsTop)
+
+/* Samples the counter on ISR exit and records the statistics of the ISR */
+#define TIMER_STATS_EXIT(vector,counter) \
+	timer_recordStats((vector),statsLatency,timer_elapsed(statsEntry,(counter),statsTop))
+#else
+#define TIMER_STATS_ENTRY(counter,match,top)
+#define TIMER_STATS_EXIT(vector,counter)
+#endif
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+#ifdef TIMER_INSTRUMENTATION
+/* Counts between two samples of a counter which wraps to zero after top */
+static uint16 timer_elapsed(const uint16 from,const uint16 to,const uint16 top)
+{
+	if(to >= from)
+	{
+		return to - from;
+	}
+	return (uint16)(((uint32)top + 1 + to) - from);
+}
+
+/* Histogram bin of a value (index of its most significant bit + 1) */
+static uint8 timer_statsBin(uint16 value)
+{
+	uint8 bin = 0;
+
+	while((value != 0) && (bin < (TIMER_STATS_BINS-1)))
+	{
+		value >>= 1;
+		bin++;
+	}
+	return bin;
+}
+
+/* Adds one ISR run to the statistics of its vector (called from the ISR so interrupts are disabled) */
+static void timer_recordStats(const timer_statsVector vector,const uint16 latency,const uint16 exec)
+{
+	timer_StatsType * stats_Ptr = &g_timerStats[vector];
+
+	if(stats_Ptr->s_count == 0xFFFF)
+	{
+		return;  /* keep the sums and the count consistent for the mean */
+	}
+
+	if((stats_Ptr->s_count == 0) || (latency < stats_Ptr->s_latencyMin))
+		stats_Ptr->s_latencyMin = latency;
+	if(latency > stats_Ptr->s_latencyMax)
+		stats_Ptr->s_latencyMax = latency;
+	if((stats_Ptr->s_count == 0) || (exec < stats_Ptr->s_execMin))
+		stats_Ptr->s_execMin = exec;
+	if(exec > stats_Ptr->s_execMax)
+		stats_Ptr->s_execMax = exec;
+
+	stats_Ptr->s_latencySum += latency;
+	stats_Ptr->s_execSum += exec;
+	stats_Ptr->s_latencyHistogram[timer_statsBin(latency)]++;
+	stats_Ptr->s_execHistogram[timer_statsBin(exec)]++;
+	stats_Ptr->s_count++;
+}
 
-static volatile void (*g_callBackPtr_0)(void) = NULL_PTR;
+/* Sends an unsigned number in decimal over UART */
+static void timer_sendNumber(uint32 number)
+{
+	char buff[11];
+	uint8 i = 0;
 
-static volatile void (*g_callBackPtr_1)(void) = NULL_PTR;
+	do {
+		buff[i++] = '0' + (number % 10);
+		number /= 10;
+	} while(number != 0);
 
-static volatile void (*g_callBackPtr_2)(void) = NULL_PTR;
+	while(i > 0)
+	{
+		UART_sendByte(buff[--i]);
+	}
+}
+
+/* Sends a string over UART (UART_sendString appends its '#' terminal so it is not used) */
+static void timer_sendText(const char *str)
+{
+	while(*str != '\0')
+	{
+		UART_sendByte(*str);
+		str++;
+	}
+}
+#endif
+
+/* Disables the compare interrupt of a timer1 channel after its scheduled event fired */
+static inline void timer1_endOneShot(const uint8 channel_bit,const uint8 interrupt_bit)
+{
+	if(BIT_IS_SET(g_timer1OneShot,channel_bit))
+	{
+		CLEAR_BIT(TIMSK,interrupt_bit);
+		CLEAR_BIT(g_timer1OneShot,channel_bit);
+	}
+}
+
+#ifdef TIMER_STATIC_CALLBACK
+
+/* Application hooks bound at compile time */
+#include "timers_hooks.h"
+
+/* Only the ISR's of the defined hooks are generated so only their interrupts are enabled */
+#ifdef TIMER0_OVF_HOOK
+#define TIMER0_OVF_HOOKED (1<<TOIE0)
+#else
+#define TIMER0_OVF_HOOKED 0
+#endif
+#ifdef TIMER0_COMP_HOOK
+#define TIMER0_COMP_HOOKED (1<<OCIE0)
+#else
+#define TIMER0_COMP_HOOKED 0
+#endif
+#ifdef TIMER1_OVF_HOOK
+#define TIMER1_OVF_HOOKED (1<<TOIE1)
+#else
+#define TIMER1_OVF_HOOKED 0
+#endif
+#ifdef TIMER1_COMPA_HOOK
+#define TIMER1_COMPA_HOOKED (1<<OCIE1A)
+#else
+#define TIMER1_COMPA_HOOKED 0
+#endif
+#ifdef TIMER1_COMPB_HOOK
+#define TIMER1_COMPB_HOOKED (1<<OCIE1B)
+#else
+#define TIMER1_COMPB_HOOKED 0
+#endif
+#ifdef TIMER2_OVF_HOOK
+#define TIMER2_OVF_HOOKED (1<<TOIE2)
+#else
+#define TIMER2_OVF_HOOKED 0
+#endif
+#ifdef TIMER2_COMP_HOOK
+#define TIMER2_COMP_HOOKED (1<<OCIE2)
+#else
+#define TIMER2_COMP_HOOKED 0
+#endif
+
+#define TIMER_HOOKED_INTERRUPTS (TIMER0_OVF_HOOKED | TIMER0_COMP_HOOKED | TIMER1_OVF_HOOKED | \
+		TIMER1_COMPA_HOOKED | TIMER1_COMPB_HOOKED | TIMER2_OVF_HOOKED | TIMER2_COMP_HOOKED)
 
 /*******************************************************************************
  *                       Interrupt Service Routines                            *
  *******************************************************************************/
 
+#ifdef TIMER0_OVF_HOOK
 ISR(TIMER0_OVF_vect)
 {
-	if(g_callBackPtr_0 != NULL_PTR)
+	TIMER_STATS_ENTRY(TCNT0,0,0xFF);
+	TIMER0_OVF_HOOK();
+	TIMER_STATS_EXIT(TIMER0_OVF_STATS,TCNT0);
+}
+#endif
+
+#ifdef TIMER0_COMP_HOOK
+ISR(TIMER0_COMP_vect)
+{
+	TIMER_STATS_ENTRY(TCNT0,0,OCR0);
+	TIMER0_COMP_HOOK();
+	TIMER_STATS_EXIT(TIMER0_COMP_STATS,TCNT0);
+}
+#endif
+
+#ifdef TIMER1_OVF_HOOK
+ISR(TIMER1_OVF_vect)
+{
+	TIMER_STATS_ENTRY(TCNT1,0,0xFFFF);
+	TIMER1_OVF_HOOK();
+	TIMER_STATS_EXIT(TIMER1_OVF_STATS,TCNT1);
+}
+#endif
+
+#ifdef TIMER1_COMPA_HOOK
+ISR(TIMER1_COMPA_vect)
+{
+	TIMER_STATS_ENTRY(TCNT1,(BIT_IS_SET(TCCR1B,WGM12) ? 0 : OCR1A),TIMER1_TOP);
+	timer1_endOneShot(0,OCIE1A);
+	TIMER1_COMPA_HOOK();
+	TIMER_STATS_EXIT(TIMER1_COMPA_STATS,TCNT1);
+}
+#endif
+
+#ifdef TIMER1_COMPB_HOOK
+ISR(TIMER1_COMPB_vect)
+{
+	TIMER_STATS_ENTRY(TCNT1,OCR1B,TIMER1_TOP);
+	timer1_endOneShot(1,OCIE1B);
+	TIMER1_COMPB_HOOK();
+	TIMER_STATS_EXIT(TIMER1_COMPB_STATS,TCNT1);
+}
+#endif
+
+#ifdef TIMER2_OVF_HOOK
+ISR(TIMER2_OVF_vect)
+{
+	TIMER_STATS_ENTRY(TCNT2,0,0xFF);
+	TIMER2_OVF_HOOK();
+	TIMER_STATS_EXIT(TIMER2_OVF_STATS,TCNT2);
+}
+#endif
+
+#ifdef TIMER2_COMP_HOOK
+ISR(TIMER2_COMP_vect)
+{
+	TIMER_STATS_ENTRY(TCNT2,0,OCR2);
+	TIMER2_COMP_HOOK();
+	TIMER_STATS_EXIT(TIMER2_COMP_STATS,TCNT2);
+}
+#endif
+
+#else
+
+/* Every timer vector has an ISR calling its call back */
+#define TIMER_HOOKED_INTERRUPTS 0xFF
+
+/* Global tables to hold the address of the call back functions in the application
+ * (one entry for each timer indexed by timer type) */
+
+static void (* volatile g_overflowCallBack[3])(void) = {NULL_PTR,NULL_PTR,NULL_PTR};
+
+static void (* volatile g_compareCallBack[3])(void) = {NULL_PTR,NULL_PTR,NULL_PTR};
+
+/* Global variable to hold the address of the call back function of timer1 compare channel B */
+static void (* volatile g_compareBCallBack)(void) = NULL_PTR;
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+
+ISR(TIMER0_OVF_vect)
+{
+	TIMER_STATS_ENTRY(TCNT0,0,0xFF);
+	void (*callBack)(void) = g_overflowCallBack[0];  /* load the volatile pointer once */
+
+	if(callBack != NULL_PTR)
 	{
 		/* Call the Call Back function in the application when timer0 overflow occur */
-		(*g_callBackPtr_0)();
+		(*callBack)();
 	}
+	TIMER_STATS_EXIT(TIMER0_OVF_STATS,TCNT0);
 }
 
 ISR(TIMER0_COMP_vect)
 {
-	if(g_callBackPtr_0 != NULL_PTR)
+	TIMER_STATS_ENTRY(TCNT0,0,OCR0);
+	void (*callBack)(void) = g_compareCallBack[0];
+
+	if(callBack != NULL_PTR)
 	{
 		/* Call the Call Back function in the application when timer0 reaches compare value */
-		(*g_callBackPtr_0)();
+		(*callBack)();
 	}
+	TIMER_STATS_EXIT(TIMER0_COMP_STATS,TCNT0);
 }
 
 ISR(TIMER1_OVF_vect)
 {
-	if(g_callBackPtr_1 != NULL_PTR)
+	TIMER_STATS_ENTRY(TCNT1,0,0xFFFF);
+	void (*callBack)(void) = g_overflowCallBack[1];
+
+	if(callBack != NULL_PTR)
 	{
 		/* Call the Call Back function in the application when timer1 overflow occur */
-		(*g_callBackPtr_1)();
+		(*callBack)();
 	}
+	TIMER_STATS_EXIT(TIMER1_OVF_STATS,TCNT1);
 }
 
 ISR(TIMER1_COMPA_vect)
 {
-	if(g_callBackPtr_1 != NULL_PTR)
+	TIMER_STATS_ENTRY(TCNT1,(BIT_IS_SET(TCCR1B,WGM12) ? 0 : OCR1A),TIMER1_TOP);
+	void (*callBack)(void) = g_compareCallBack[1];
+
+	timer1_endOneShot(0,OCIE1A);
+
+	if(callBack != NULL_PTR)
 	{
 		/* Call the Call Back function in the application when timer1 reaches compare value */
-		(*g_callBackPtr_1)();
+		(*callBack)();
+	}
+	TIMER_STATS_EXIT(TIMER1_COMPA_STATS,TCNT1);
+}
+
+ISR(TIMER1_COMPB_vect)
+{
+	TIMER_STATS_ENTRY(TCNT1,OCR1B,TIMER1_TOP);
+	void (*callBack)(void) = g_compareBCallBack;
+
+	timer1_endOneShot(1,OCIE1B);
+
+	if(callBack != NULL_PTR)
+	{
+		/* Call the Call Back function in the application when timer1 reaches compare B value */
+		(*callBack)();
 	}
+	TIMER_STATS_EXIT(TIMER1_COMPB_STATS,TCNT1);
 }
 
 
 ISR(TIMER2_OVF_vect)
 {
-	if(g_callBackPtr_2 != NULL_PTR)
+	TIMER_STATS_ENTRY(TCNT2,0,0xFF);
+	void (*callBack)(void) = g_overflowCallBack[2];
+
+	if(callBack != NULL_PTR)
 	{
 		/* Call the Call Back function in the application when timer2 overflow occur */
-		(*g_callBackPtr_2)();
+		(*callBack)();
 	}
+	TIMER_STATS_EXIT(TIMER2_OVF_STATS,TCNT2);
 }
 
 ISR(TIMER2_COMP_vect)
 {
-	if(g_callBackPtr_2 != NULL_PTR)
+	TIMER_STATS_ENTRY(TCNT2,0,OCR2);
+	void (*callBack)(void) = g_compareCallBack[2];
+
+	if(callBack != NULL_PTR)
 	{
 		/* Call the Call Back function in the application when timer2 reaches compare value */
-		(*g_callBackPtr_2)();
+		(*callBack)();
 	}
+	TIMER_STATS_EXIT(TIMER2_COMP_STATS,TCNT2);
 }
 
+#endif /* TIMER_STATIC_CALLBACK */
+
 
 
 /*******************************************************************************
@@ -128,13 +431,13 @@ void timer_init(const timer_ConfigType * config_Ptr)
 
 		if(config_Ptr->s_mode==0){   /* In case normal mode */
 
-			SET_BIT(TIMSK,TOIE0);  /* Enabling overflow mode interrupt*/
+			TIMER_ENABLE_INTERRUPT(TOIE0);  /* Enabling overflow mode interrupt*/
 		}
 
 		else if (config_Ptr->s_mode==2){  /* In case compare mode */
 
 			OCR0 = config_Ptr->s_copmareValue;  /* setting required compare value */
-			SET_BIT(TIMSK,OCIE0);       /* Enabling compare match interrupt*/
+			TIMER_ENABLE_INTERRUPT(OCIE0);       /* Enabling compare match interrupt*/
 		}
 
 	}
@@ -166,13 +469,13 @@ void timer_init(const timer_ConfigType * config_Ptr)
 
 		if(config_Ptr->s_mode==0){  /* In case normal mode */
 
-			SET_BIT(TIMSK,TOIE2);   /* Enabling overflow mode interrupt*/
+			TIMER_ENABLE_INTERRUPT(TOIE2);   /* Enabling overflow mode interrupt*/
 		}
 
 		else if (config_Ptr->s_mode==2){  /* In case compare mode */
 
 			OCR2 = config_Ptr->s_copmareValue; /* setting required compare value */
-			SET_BIT(TIMSK,OCIE2);  /* Enabling compare match interrupt*/
+			TIMER_ENABLE_INTERRUPT(OCIE2);  /* Enabling compare match interrupt*/
 		}
 
 	}
@@ -206,16 +509,30 @@ void timer_init(const timer_ConfigType * config_Ptr)
 		if(config_Ptr->s_mode==0){  /* In case normal mode */
 
 			CLEAR_BIT(TCCR1B,WGM12); /* setting timer mode to normal */
-			SET_BIT(TIMSK,TOIE1);   /* Enabling overflow mode interrupt*/
+			CLEAR_BIT(TIMSK,OCIE1A);   /* Disabling compare match interrupt (left by a previous init or event) */
+			TIMER_ENABLE_INTERRUPT(TOIE1);   /* Enabling overflow mode interrupt*/
 			}
 
 		else if (config_Ptr->s_mode==2){  /* In case compare mode */
 
 			SET_BIT(TCCR1B,WGM12);  /* setting timer mode to CTC */
+			CLEAR_BIT(TIMSK,TOIE1);   /* Disabling overflow mode interrupt (left by a previous init) */
 			OCR1A = config_Ptr->s_copmareValue;  /* setting required compare value */
-			SET_BIT(TIMSK,OCIE1A);   /* Enabling compare match interrupt*/
+			TIMER_ENABLE_INTERRUPT(OCIE1A);   /* Enabling compare match interrupt*/
+			}
+
+		if(config_Ptr->s_compareValueB != 0){  /* In case channel B is used (in normal or compare mode) */
+
+			OCR1B = config_Ptr->s_compareValueB;  /* setting required compare B value */
+			TIMER_ENABLE_INTERRUPT(OCIE1B);   /* Enabling compare B match interrupt*/
+			}
+		else{
+
+			CLEAR_BIT(TIMSK,OCIE1B);   /* Disabling compare B match interrupt (left by a previous init or event) */
 			}
 
+		g_timer1OneShot = 0;  /* channels fire every time the counter matches */
+
 
 	}
 }
@@ -224,6 +541,8 @@ void timer_init(const timer_ConfigType * config_Ptr)
 
 
 
+#ifndef TIMER_STATIC_CALLBACK
+
 /*************************************************************************************************
  *  [Function Name]:    timer0_setCallBack
  *  [Description] :		This Function stores the address of the function wanted to be called when
@@ -235,8 +554,9 @@ void timer_init(const timer_ConfigType * config_Ptr)
 
 void timer0_setCallBack(void(*a_ptr_0)(void))
 {
-	/* Save the address of the Call back function in a global variable */
-	g_callBackPtr_0 = a_ptr_0;
+	/* Save the address of the Call back function for both overflow and compare interrupts */
+	g_overflowCallBack[0] = a_ptr_0;
+	g_compareCallBack[0] = a_ptr_0;
 }
 
 
@@ -253,8 +573,9 @@ void timer0_setCallBack(void(*a_ptr_0)(void))
 
 void timer1_setCallBack(void(*a_ptr_1)(void))
 {
-	/* Save the address of the Call back function in a global variable */
-	g_callBackPtr_1 = a_ptr_1;
+	/* Save the address of the Call back function for both overflow and compare interrupts */
+	g_overflowCallBack[1] = a_ptr_1;
+	g_compareCallBack[1] = a_ptr_1;
 }
 
 
@@ -272,10 +593,45 @@ void timer1_setCallBack(void(*a_ptr_1)(void))
 
 void timer2_setCallBack(void(*a_ptr_2)(void))
 {
-	/* Save the address of the Call back function in a global variable */
-	g_callBackPtr_2 = a_ptr_2;
+	/* Save the address of the Call back function for both overflow and compare interrupts */
+	g_overflowCallBack[2] = a_ptr_2;
+	g_compareCallBack[2] = a_ptr_2;
+}
+
+
+
+
+
+/*************************************************************************************************
+ *  [Function Name]:    timer_setEventCallBack
+ *  [Description] :		This Function stores the address of the function wanted to be called when
+ *                      a certain interrupt (overflow or compare) occur from a certain timer
+ *  [Args] :            Uint8 timer_type
+ *                         timer type (0,1,2)
+ *                      timer_event event
+ *                         TIMER_OVERFLOW or TIMER_COMPARE or TIMER_COMPARE_B (timer1 only)
+ *                      void(*a_ptr)(void)
+ *                         Address of the function that will be called when the interrupt occur
+ *  [Returns] :	    	NONE
+ ***************************************************************************************************/
+
+void timer_setEventCallBack(const uint8 timer_type,const timer_event event,void(*a_ptr)(void))
+{
+	if(timer_type > 2)
+		return;
+
+	if(event == TIMER_OVERFLOW){
+		g_overflowCallBack[timer_type] = a_ptr;
+	}
+	else if(event == TIMER_COMPARE){
+		g_compareCallBack[timer_type] = a_ptr;
+	}
+	else if((event == TIMER_COMPARE_B) && (timer_type == 1)){
+		g_compareBCallBack = a_ptr;
+	}
 }
 
+#endif /* TIMER_STATIC_CALLBACK */
 
 
 
@@ -294,7 +650,7 @@ void timer_stop(const uint8 timer_type){
 
 
 		CLEAR_BIT(TIMSK,TOIE0); /* Disable timer0 overflow interrupt*/
-		SET_BIT(TIMSK,OCIE0);  /* Disable timer0 compare match interrupt*/
+		CLEAR_BIT(TIMSK,OCIE0);  /* Disable timer0 compare match interrupt*/
 
 		/* Clear All Timer0 Registers */
 		TCCR0 = 0;
@@ -306,7 +662,7 @@ void timer_stop(const uint8 timer_type){
 
 
 		CLEAR_BIT(TIMSK,TOIE2);  /* Disable timer2 overflow interrupt*/
-		SET_BIT(TIMSK,OCIE2);   /* Disable timer2 compare match interrupt*/
+		CLEAR_BIT(TIMSK,OCIE2);   /* Disable timer2 compare match interrupt*/
 
 		/* Clear All Timer2 Registers */
 		TCCR2 = 0;
@@ -319,14 +675,195 @@ void timer_stop(const uint8 timer_type){
 
 		CLEAR_BIT(TIMSK,TOIE1);   /* Disable timer1 overflow interrupt*/
 		CLEAR_BIT(TIMSK,OCIE1A);   /* Disable timer1 compare match interrupt*/
+		CLEAR_BIT(TIMSK,OCIE1B);   /* Disable timer1 compare B match interrupt*/
+		g_timer1OneShot = 0;
 
 		/* Clear All Timer1 Registers */
 		TCCR1A = 0;
 		TCCR1B = 0;
 		TCNT1 = 0;
 		OCR1A = 0;
+		OCR1B = 0;
 	}
 
 
 
 }
+
+
+
+/*************************************************************************************************
+ *  [Function Name]:    timer1_scheduleEvent
+ *  [Description] :		This Function schedules one compare interrupt of timer1 when TCNT1 reaches
+ *                      a certain tick, the interrupt is disabled again after it fires so the
+ *                      call back may schedule the next event
+ *  [Args] :            timer_event channel
+ *                         TIMER_COMPARE for channel A or TIMER_COMPARE_B for channel B
+ *                      uint16 tick
+ *                         absolute value of TCNT1 at which the call back is called
+ *  [Returns] :			NONE
+ *  [Remarks] :         Timer1 must run in normal mode to use channel A (in compare mode OCR1A is
+ *                      the top value), channel B can be used in both modes
+ *                      A tick which already passed fires after the counter wraps around
+ *                      With TIMER_STATIC_CALLBACK the channel needs its hook (TIMER1_COMPA_HOOK or
+ *                      TIMER1_COMPB_HOOK) otherwise nothing is scheduled
+ ***************************************************************************************************/
+
+void timer1_scheduleEvent(const timer_event channel,const uint16 tick)
+{
+	/* Writing the 16-bit compare register uses the shared TEMP register so it must not be interrupted */
+	ATOMIC_BEGIN();
+
+	if(channel == TIMER_COMPARE){
+		OCR1A = tick;
+		TIFR = (1<<OCF1A);        /* clear old compare A match flag (written by logic one) */
+		SET_BIT(g_timer1OneShot,0);
+		TIMER_ENABLE_INTERRUPT(OCIE1A);     /* Enabling compare match interrupt*/
+	}
+	else if(channel == TIMER_COMPARE_B){
+		OCR1B = tick;
+		TIFR = (1<<OCF1B);        /* clear old compare B match flag (written by logic one) */
+		SET_BIT(g_timer1OneShot,1);
+		TIMER_ENABLE_INTERRUPT(OCIE1B);     /* Enabling compare B match interrupt*/
+	}
+
+	ATOMIC_END();
+}
+
+
+
+/*************************************************************************************************
+ *  [Function Name]:    timer1_getTicks
+ *  [Description] :		This Function returns the current count of timer1 (to compute absolute ticks of events)
+ *  [Args] :            NONE
+ *  [Returns] :			uint16
+ *                         TCNT1 value
+ ***************************************************************************************************/
+
+uint16 timer1_getTicks(void)
+{
+	/* 16-bit read uses the shared TEMP register so it must not be interrupted */
+	return ATOMIC_READ16(TCNT1);
+}
+
+
+
+#ifdef TIMER_INSTRUMENTATION
+/*************************************************************************************************
+ *  [Function Name]:    timer_getStats
+ *  [Description] :		This Function copies the ISR statistics of a certain timer interrupt
+ *                      (latency and execution time are in counts of the timer of that interrupt)
+ *  [Args] :            timer_statsVector vector
+ *                         the timer interrupt (TIMER0_OVF_STATS ... TIMER2_COMP_STATS)
+ *                      Pointer to Struct timer_StatsType
+ *                         the statistics will be copied to it
+ *  [Returns] :			NONE
+ ***************************************************************************************************/
+
+void timer_getStats(const timer_statsVector vector,timer_StatsType * stats_Ptr)
+{
+	if(vector >= TIMER_STATS_VECTORS)
+		return;
+
+	/* The ISR must not update the statistics while they are copied */
+	ATOMIC_BEGIN();
+	*stats_Ptr = g_timerStats[vector];
+	ATOMIC_END();
+}
+
+
+
+/*************************************************************************************************
+ *  [Function Name]:    timer_resetStats
+ *  [Description] :		This Function clears the ISR statistics of all timer interrupts
+ *  [Args] :            NONE
+ *  [Returns] :			NONE
+ ***************************************************************************************************/
+
+void timer_resetStats(void)
+{
+	uint8 vector;
+	uint8 bin;
+
+	ATOMIC_BEGIN();
+	for(vector=0;vector<TIMER_STATS_VECTORS;vector++)
+	{
+		g_timerStats[vector].s_count = 0;
+		g_timerStats[vector].s_latencyMin = 0;
+		g_timerStats[vector].s_latencyMax = 0;
+		g_timerStats[vector].s_latencySum = 0;
+		g_timerStats[vector].s_execMin = 0;
+		g_timerStats[vector].s_execMax = 0;
+		g_timerStats[vector].s_execSum = 0;
+		for(bin=0;bin<TIMER_STATS_BINS;bin++)
+		{
+			g_timerStats[vector].s_latencyHistogram[bin] = 0;
+			g_timerStats[vector].s_execHistogram[bin] = 0;
+		}
+	}
+	ATOMIC_END();
+}
+
+
+
+/*************************************************************************************************
+ *  [Function Name]:    timer_dumpStats
+ *  [Description] :		This Function sends the ISR statistics of every timer interrupt that occurred
+ *                      over UART, one line for each interrupt:
+ *                      <name> n=<count> lat=<min>/<mean>/<max> exe=<min>/<mean>/<max> hl=<bins> he=<bins>
+ *  [Args] :            NONE
+ *  [Returns] :			NONE
+ ***************************************************************************************************/
+
+void timer_dumpStats(void)
+{
+	timer_StatsType stats;
+	uint8 vector;
+	uint8 bin;
+
+	for(vector=0;vector<TIMER_STATS_VECTORS;vector++)
+	{
+		timer_getStats(vector,&stats);
+		if(stats.s_count == 0)
+		{
+			continue;
+		}
+
+		timer_sendText(g_timerStatsNames[vector]);
+		timer_sendText(" n=");
+		timer_sendNumber(stats.s_count);
+
+		timer_sendText(" lat=");
+		timer_sendNumber(stats.s_latencyMin);
+		UART_sendByte('/');
+		timer_sendNumber(stats.s_latencySum / stats.s_count);
+		UART_sendByte('/');
+		timer_sendNumber(stats.s_latencyMax);
+
+		timer_sendText(" exe=");
+		timer_sendNumber(stats.s_execMin);
+		UART_sendByte('/');
+		timer_sendNumber(stats.s_execSum / stats.s_count);
+		UART_sendByte('/');
+		timer_sendNumber(stats.s_execMax);
+
+		timer_sendText(" hl=");
+		for(bin=0;bin<TIMER_STATS_BINS;bin++)
+		{
+			if(bin != 0)
+				UART_sendByte(',');
+			timer_sendNumber(stats.s_latencyHistogram[bin]);
+		}
+
+		timer_sendText(" he=");
+		for(bin=0;bin<TIMER_STATS_BINS;bin++)
+		{
+			if(bin != 0)
+				UART_sendByte(',');
+			timer_sendNumber(stats.s_execHistogram[bin]);
+		}
+
+		timer_sendText("\r\n");
+	}
+}
+#endif
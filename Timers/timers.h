@@ -17,6 +17,36 @@
 #include "common_macros.h"
 #include "micro_configurations.h"
 
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Call back binding mode:
+ * Run time binding (default): call back functions are set using the set call back functions
+ * Compile time binding: the application provides "timers_hooks.h" which defines the hooks
+ *   TIMER0_OVF_HOOK() , TIMER0_COMP_HOOK() , TIMER1_OVF_HOOK() , TIMER1_COMPA_HOOK() ,
+ *   TIMER1_COMPB_HOOK() , TIMER2_OVF_HOOK() , TIMER2_COMP_HOOK()
+ *   (only the ISR's of the defined hooks are generated and only their interrupts are enabled,
+ *   a hook may be a static inline function so it is inlined in the ISR without loading a
+ *   function pointer)
+ *   The hooks are compiled into timers.c , so the library is built for one application :
+ *   make TIMERS_HOOKS_DIR=<directory of timers_hooks.h> , and rebuilt (make clean) for another */
+#define TIMER_STATIC_CALLBACK
+#undef TIMER_STATIC_CALLBACK  /* Remove This line in case you want to use compile time binding */
+
+/* ISR instrumentation: every timer ISR samples its counter on entry and exit and keeps
+ * latency (counts from the match/overflow until the ISR starts) and execution time
+ * statistics in timer counts, timer_dumpStats uses the UART driver (UART must be initialized)
+ * make TIMER_INSTRUMENTATION=1 builds the library with it (compile the application with
+ * -DTIMER_INSTRUMENTATION too) , the UART driver must be built in the library */
+#ifndef TIMER_INSTRUMENTATION
+#define TIMER_INSTRUMENTATION
+#undef TIMER_INSTRUMENTATION  /* Remove This line in case you want to measure the timer ISR's */
+#endif
+
+/* Number of histogram bins, bin 0 counts 0 , bin n counts from 2^(n-1) to 2^n - 1 and the last bin counts the rest */
+#define TIMER_STATS_BINS 8
+
 /*******************************************************************************
  *                         Types Declaration                                   *
  *******************************************************************************/
@@ -42,8 +72,34 @@ typedef struct
 	timer_01_clock s_clock01;
 	timer_2_clock s_clock2;
 	uint16 s_copmareValue;
+	uint16 s_compareValueB;  /* timer1 only, compare value of channel B (0 if channel B is not used) */
 }timer_ConfigType;
 
+/* TIMER_COMPARE is channel A in case of timer1 , TIMER_COMPARE_B is for timer1 only */
+typedef enum{
+	TIMER_OVERFLOW,TIMER_COMPARE,TIMER_COMPARE_B
+}timer_event;
+
+#ifdef TIMER_INSTRUMENTATION
+typedef enum{
+	TIMER0_OVF_STATS,TIMER0_COMP_STATS,TIMER1_OVF_STATS,TIMER1_COMPA_STATS,TIMER1_COMPB_STATS,
+	TIMER2_OVF_STATS,TIMER2_COMP_STATS,TIMER_STATS_VECTORS
+}timer_statsVector;
+
+typedef struct
+{
+	uint16 s_count;          /* number of recorded interrupts (saturates) */
+	uint16 s_latencyMin;
+	uint16 s_latencyMax;
+	uint32 s_latencySum;     /* mean = s_latencySum / s_count */
+	uint16 s_execMin;
+	uint16 s_execMax;
+	uint32 s_execSum;        /* mean = s_execSum / s_count */
+	uint16 s_latencyHistogram[TIMER_STATS_BINS];
+	uint16 s_execHistogram[TIMER_STATS_BINS];
+}timer_StatsType;
+#endif
+
 
 /*******************************************************************************
  *                      Functions Prototypes                                   *
@@ -56,6 +112,7 @@ typedef struct
  *  4-Set required compare value in case of compare mode */
 void timer_init(const timer_ConfigType * config_Ptr);
 
+#ifndef TIMER_STATIC_CALLBACK
 /* Function stores the address of the function wanted to be called when interrupt occur from overflow mode or CTC mode of timer 0 */
 void timer0_setCallBack(void(*a_ptr_0)(void));
 
@@ -65,9 +122,30 @@ void timer1_setCallBack(void(*a_ptr_1)(void));
 /* Function stores the address of the function wanted to be called when interrupt occur from overflow mode or CTC mode of timer 2 */
 void timer2_setCallBack(void(*a_ptr_2)(void));
 
+/* Function stores the address of the function wanted to be called when a certain interrupt (overflow or compare) occur from a certain timer */
+void timer_setEventCallBack(const uint8 timer_type,const timer_event event,void(*a_ptr)(void));
+#endif
+
 /* Function disables timer0 or timer1 or timer2 */
 void timer_stop(const uint8 timer_type);
 
+/* Function schedules one compare interrupt of timer1 channel A or B when TCNT1 reaches a certain tick */
+void timer1_scheduleEvent(const timer_event channel,const uint16 tick);
+
+/* Function returns the current count of timer1 */
+uint16 timer1_getTicks(void);
+
+#ifdef TIMER_INSTRUMENTATION
+/* Function copies the ISR statistics of a certain timer interrupt */
+void timer_getStats(const timer_statsVector vector,timer_StatsType * stats_Ptr);
+
+/* Function clears the ISR statistics of all timer interrupts */
+void timer_resetStats(void);
+
+/* Function sends the ISR statistics of all timer interrupts over UART */
+void timer_dumpStats(void);
+#endif
+
 
 
 #endif /* TIMERS_H_ */
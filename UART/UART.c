@@ -32,7 +32,7 @@
  ***************************************************************************************************/
 void UART_init(const UART_ConfigType * config_Ptr){
 
-	SET_BIT(UCSRA,U2X) ; /* U2X = 1 for double transmission speed */
+	REG_SET_BIT(UCSRA,U2X) ; /* U2X = 1 for double transmission speed */
 
 	/************************** UCSRB Description **************************
 	 * RXCIE = 0 Disable USART RX Complete Interrupt Enable
@@ -43,8 +43,8 @@ void UART_init(const UART_ConfigType * config_Ptr){
 	 * UCSZ2 = 0 For 8-bit data mode
 	 * RXB8 & TXB8 not used for 8-bit data mode
 	 ***********************************************************************/
-	UCSRB = (1<<RXEN) | (1<<TXEN);
-	UCSRB = (UCSRB & 0xFB) | ((config_Ptr->s_dataBits) & 0x04);  /* setting UCSZ2 bit for the required data bit mode */
+	REG_WRITE(UCSRB,(1<<RXEN) | (1<<TXEN));
+	REG_WRITE(UCSRB,(REG_READ(UCSRB) & 0xFB) | ((config_Ptr->s_dataBits) & 0x04));  /* setting UCSZ2 bit for the required data bit mode */
 
 	/************************** UCSRC Description **************************
 	 * URSEL   = 1 The URSEL must be one when writing the UCSRC  ,0 when writing in UBRR
@@ -54,16 +54,16 @@ void UART_init(const UART_ConfigType * config_Ptr){
 	 * UCSZ1:0 = 11 For 8-bit data mode
 	 * UCPOL   = 0 Used with the Synchronous operation only
 	 ***********************************************************************/
-	UCSRC = (1<<URSEL);
-	UCSRC = (UCSRC & 0xF9) | (((config_Ptr->s_dataBits) & 0x03)<<1); /* setting UCSZ1:0 bits for the required data bit mode */
-	UCSRC = (UCSRC & 0xCF) | ((config_Ptr->s_parity)<<4); /* setting UPM1:0 bits for the required parity type */
-	UCSRC = (UCSRC & 0xF7) | ((config_Ptr->s_stopBits)<<3); /* setting USBS bit for the required number of stop bits*/
+	REG_WRITE(UCSRC,(1<<URSEL));
+	REG_WRITE(UCSRC,(REG_READ(UCSRC) & 0xF9) | (((config_Ptr->s_dataBits) & 0x03)<<1)); /* setting UCSZ1:0 bits for the required data bit mode */
+	REG_WRITE(UCSRC,(REG_READ(UCSRC) & 0xCF) | ((config_Ptr->s_parity)<<4)); /* setting UPM1:0 bits for the required parity type */
+	REG_WRITE(UCSRC,(REG_READ(UCSRC) & 0xF7) | ((config_Ptr->s_stopBits)<<3)); /* setting USBS bit for the required number of stop bits*/
 
 
 	/* First 8 bits from the BAUD_PRESCALE inside UBRRL and last 4 bits in UBRRH*/
-	CLEAR_BIT(UCSRC,URSEL); /* Clearing URSEL to write in UBRR (because UCSRC & UBRR share address location in memory)  */
-	UBRRL = (((F_CPU / ((config_Ptr->s_UART_BaudRate) * 8UL))) - 1);  /* Equation to calculate required baud rate prescale(UBRR) (from data sheet) */
-	UBRRH = (((F_CPU / ((config_Ptr->s_UART_BaudRate) * 8UL))) - 1)>>8;
+	REG_CLEAR_BIT(UCSRC,URSEL); /* Clearing URSEL to write in UBRR (because UCSRC & UBRR share address location in memory)  */
+	REG_WRITE(UBRRL,(((F_CPU / ((config_Ptr->s_UART_BaudRate) * 8UL))) - 1));  /* Equation to calculate required baud rate prescale(UBRR) (from data sheet) */
+	REG_WRITE(UBRRH,(((F_CPU / ((config_Ptr->s_UART_BaudRate) * 8UL))) - 1)>>8);
 
 }
 
@@ -79,10 +79,10 @@ void UART_sendByte(const uint8 data){
 
 	/* UDRE flag is set when the Tx buffer (UDR) is empty and ready for
 	 * transmitting a new byte so wait until this flag is set to one */
-	while(BIT_IS_CLEAR(UCSRA,UDRE)){}
+	while(REG_BIT_IS_CLEAR(UCSRA,UDRE)){}
 	/* Put the required data in the UDR register and it also "clear the UDRE flag" as
 	 * the UDR register is not empty now */
-	UDR = data;
+	REG_WRITE(UDR,data);
 	/************************* Another Method *************************
 	UDR = data;
 	while(BIT_IS_CLEAR(UCSRA,TXC)){} // Wait until the transmission is complete TXC = 1
@@ -104,10 +104,10 @@ uint8 UART_recieveByte(void){
 
 	/* RXC flag is set when the UART receive data so wait until this
 	 * flag is set to one */
-	while(BIT_IS_CLEAR(UCSRA,RXC)){}
+	while(REG_BIT_IS_CLEAR(UCSRA,RXC)){}
 	/* Read the received data from the Rx buffer (UDR) and the "RXC flag
 	   will be cleared" after read this data */
-    return UDR;
+    return REG_READ(UDR);
 }
 
 
@@ -15,13 +15,13 @@
 void TWI_init(const TWI_ConfigType * config_Ptr)
 {
 	/* setting required bit rate using zero pre-scaler TWPS=00 and F_CPU */
-	TWBR = config_Ptr->s_TWBR;
-	TWSR &= 0xFC;
+	REG_WRITE(TWBR,config_Ptr->s_TWBR);
+	REG_WRITE(TWSR,REG_READ(TWSR) & 0xFC);
 
 	/* Two Wire Bus address my address if any master device want to call me: 0x1 (used in case this MC is a slave device)
 	       General Call Recognition: Off */
-	TWAR = ((config_Ptr->s_slave_address)<<1) | 0x01; /* my address */
-	TWCR = (1<<TWEN); /*Enable TWI*/
+	REG_WRITE(TWAR,((config_Ptr->s_slave_address)<<1) | 0x01); /* my address */
+	REG_WRITE(TWCR,(1<<TWEN)); /*Enable TWI*/
 }
 
 
@@ -32,10 +32,10 @@ void TWI_start(void)
 	 * send the start bit by TWSTA=1
 	 * Enable TWI Module TWEN=1
 	 */
-    TWCR = (1 << TWINT) | (1 << TWSTA) | (1 << TWEN);
+    REG_WRITE(TWCR,(1 << TWINT) | (1 << TWSTA) | (1 << TWEN));
 
     /* Wait for TWINT flag set in TWCR Register (start bit is send successfully) */
-    while(BIT_IS_CLEAR(TWCR,TWINT));
+    while(REG_BIT_IS_CLEAR(TWCR,TWINT));
 }
 
 void TWI_stop(void)
@@ -45,20 +45,20 @@ void TWI_stop(void)
 	 * send the stop bit by TWSTO=1
 	 * Enable TWI Module TWEN=1
 	 */
-    TWCR = (1 << TWINT) | (1 << TWSTO) | (1 << TWEN);
+    REG_WRITE(TWCR,(1 << TWINT) | (1 << TWSTO) | (1 << TWEN));
 }
 
 void TWI_write(uint8 data)
 {
     /* Put data On TWI data Register */
-    TWDR = data;
+    REG_WRITE(TWDR,data);
     /*
 	 * Clear the TWINT flag before sending the data TWINT=1
 	 * Enable TWI Module TWEN=1
 	 */
-    TWCR = (1 << TWINT) | (1 << TWEN);
+    REG_WRITE(TWCR,(1 << TWINT) | (1 << TWEN));
     /* Wait for TWINT flag set in TWCR Register(data is send successfully) */
-    while(BIT_IS_CLEAR(TWCR,TWINT));
+    while(REG_BIT_IS_CLEAR(TWCR,TWINT));
 }
 
 uint8 TWI_readWithACK(void)
@@ -68,11 +68,11 @@ uint8 TWI_readWithACK(void)
 	 * Enable sending ACK after reading or receiving data TWEA=1
 	 * Enable TWI Module TWEN=1
 	 */
-    TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWEA);
+    REG_WRITE(TWCR,(1 << TWINT) | (1 << TWEN) | (1 << TWEA));
     /* Wait for TWINT flag set in TWCR Register (data received successfully) */
-    while(BIT_IS_CLEAR(TWCR,TWINT));
+    while(REG_BIT_IS_CLEAR(TWCR,TWINT));
     /* Read Data */
-    return TWDR;
+    return REG_READ(TWDR);
 }
 
 uint8 TWI_readWithNACK(void)
@@ -81,17 +81,17 @@ uint8 TWI_readWithNACK(void)
 	 * Clear the TWINT flag before reading the data TWINT=1
 	 * Enable TWI Module TWEN=1
 	 */
-    TWCR = (1 << TWINT) | (1 << TWEN);
+    REG_WRITE(TWCR,(1 << TWINT) | (1 << TWEN));
     /* Wait for TWINT flag set in TWCR Register (data received successfully) */
-    while(BIT_IS_CLEAR(TWCR,TWINT));
+    while(REG_BIT_IS_CLEAR(TWCR,TWINT));
     /* Read Data */
-    return TWDR;
+    return REG_READ(TWDR);
 }
 
 uint8 TWI_getStatus(void)
 {
     uint8 status;
     /* masking to eliminate first 3 bits and get the last 5 bits (status bits) */
-    status = TWSR & 0xF8;
+    status = REG_READ(TWSR) & 0xF8;
     return status;
 }
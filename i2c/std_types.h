@@ -1,45 +0,0 @@
- /******************************************************************************
- *
- * Module: Common - Platform Types Abstraction
- *
- * File Name: std_types.h
- *
- * Description: types for AVR
- *
- * Author: Ganna Ahmed
- *
- *******************************************************************************/
-
-#ifndef STD_TYPES_H_
-#define STD_TYPES_H_
-
-typedef unsigned char bool;
-
-#ifndef FALSE
-#define FALSE (0u)
-#endif
-
-#ifndef TRUE
-#define TRUE (1u)
-#endif
-
-#define HIGH (1u)
-#define LOW (0u)
-
-#define NULL_PTR    ((void*)0)
-
-typedef unsigned char uint8;                            /*           0:255              */
-typedef signed char sint8;                             /*           -128:+127          */
-typedef unsigned short uint16;                         /*           0:65535            */
-typedef signed short sint16;                          /*       -32768:+32767           */
-typedef unsigned long uint32;                        /*          0:4294967295         */
-typedef signed long sint32;                         /*   -2147483648:+2147483647      */
-typedef unsigned long long uint64;                 /*       0:18446744073709551615   */
-typedef signed long long sint64;
-typedef float float32;
-typedef double double64;
-
-
-
-
-#endif /* STD_TYPES_H_ */